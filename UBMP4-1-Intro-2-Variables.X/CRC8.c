@@ -0,0 +1,34 @@
+/*==============================================================================
+ File: CRC8.c
+ Date: October 18, 2026
+
+ CRC-8 (polynomial 0x07) used to check optical link frames and sync bus
+ messages. Include CRC8.h in your program to call this function.
+==============================================================================*/
+
+#include    "CRC8.h"            // Include CRC-8 function definitions
+
+// Return the CRC-8 (polynomial 0x07) of a buffer.
+unsigned char CRC8_calc(const unsigned char *data, unsigned char length)
+{
+    unsigned char crc = 0;
+    unsigned char bit;
+
+    while(length != 0)
+    {
+        crc ^= *data++;
+        for(bit = 0; bit != 8; bit++)
+        {
+            if(crc & 0x80)
+            {
+                crc = (crc << 1) ^ 0x07;
+            }
+            else
+            {
+                crc <<= 1;
+            }
+        }
+        length--;
+    }
+    return (crc);
+}
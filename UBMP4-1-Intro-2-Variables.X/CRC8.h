@@ -0,0 +1,21 @@
+/*==============================================================================
+ File: CRC8.h
+ Date: October 18, 2026
+
+ CRC-8 (polynomial 0x07) function prototype
+
+ CRC8.c does not use any PIC hardware, so it is shared by the optical link
+ (OPTICAL.c), the sync bus messages (SYNCMSG.c) and the Linux sync bus
+ simulation (sim/syncbus_sim.c).
+==============================================================================*/
+
+// Prototypes for CRC8.c functions:
+
+/**
+ * Function: unsigned char CRC8_calc(const unsigned char *data, unsigned char length)
+ *
+ * Return the CRC-8 (polynomial 0x07, initial value 0) of length bytes of data.
+ *
+ * Example usage: frame[5] = CRC8_calc(frame, 5);
+ */
+unsigned char CRC8_calc(const unsigned char *, unsigned char);
@@ -0,0 +1,401 @@
+/*==============================================================================
+ File: EUSART.c
+ Date: October 18, 2026
+
+ UBMP4.1 (PIC16F1459) buffered, interrupt-driven EUSART serial driver
+
+ Transmit data is held in a queue of (pointer, length) entries. Caller-owned
+ buffers are queued by reference, and characters copied into the internal
+ transmit ring buffer are queued as contiguous ring segments, so that both
+ kinds of data are sent in order. Main program functions disable the transmit
+ interrupt (TXIE) while they update the queue instead of disabling all
+ interrupts. Include EUSART.h in your main program to call these functions.
+==============================================================================*/
+
+#include    "xc.h"              // XC compiler general include file
+
+#include    "stdint.h"          // Include integer definitions
+#include    "stdbool.h"         // Include Boolean (true/false) definitions
+
+#include    "UBMP410.h"         // Include UBMP4.1 constant and function definitions
+#include    "EUSART.h"          // Include EUSART constant and function definitions
+
+// Buffer index masks (ring and queue sizes are powers of 2)
+#define TX_RING_MASK    (EUSART_TX_RING_SIZE - 1)
+#define RX_RING_MASK    (EUSART_RX_RING_SIZE - 1)
+#define TX_QUEUE_MASK   (EUSART_TX_QUEUE_SIZE - 1)
+
+// Transmit queue. Head is advanced by the main program, tail by EUSART_isr().
+const unsigned char *txQueueStart[EUSART_TX_QUEUE_SIZE];    // Queued buffer
+const unsigned char *volatile txQueuePtr[EUSART_TX_QUEUE_SIZE];  // Next byte
+volatile unsigned char txQueueLen[EUSART_TX_QUEUE_SIZE];    // Bytes left
+bool txQueueRing[EUSART_TX_QUEUE_SIZE];     // Entry is a tx ring segment
+unsigned char txQueueHead = 0;
+volatile unsigned char txQueueTail = 0;
+
+// Transmit ring buffer for copied characters. Free-running 8-bit indexes.
+unsigned char txRing[EUSART_TX_RING_SIZE];
+unsigned char txRingHead = 0;
+volatile unsigned char txRingTail = 0;
+
+// Receive ring buffer. Head is advanced by EUSART_isr(), tail by EUSART_getc().
+volatile unsigned char rxRing[EUSART_RX_RING_SIZE];
+volatile unsigned char rxRingHead = 0;
+unsigned char rxRingTail = 0;
+
+// Hexadecimal digit look-up table for the formatter
+const unsigned char hexDigits[16] = "0123456789ABCDEF";
+
+// Configure EUSART for asynchronous 8N1 operation using a baud rate constant
+// defined in EUSART.h (eg. BAUD_115200). Enables TX and peripheral interrupts.
+void EUSART_config(unsigned int brg)
+{
+    TRISBbits.TRISB5 = 1;       // RX pin must be an input (SW3)
+    TRISBbits.TRISB7 = 1;       // TX pin is driven by the EUSART when enabled
+    SPBRGL = (unsigned char)brg;        // Set baud rate generator low byte
+    SPBRGH = (unsigned char)(brg >> 8); // Set baud rate generator high byte
+    BAUDCON = 0b00001000;       // 16-bit baud rate generator, idle high TX
+    TXSTA = 0b00100100;         // 8-bit asynchronous TX enabled, high speed
+    RCSTA = 0b10000000;         // Serial port enabled, receiver off
+    TXIE = 0;                   // Transmit interrupt is enabled by queueing
+    PEIE = 1;                   // Enable peripheral interrupts
+    GIE = 1;                    // Enable global interrupts
+}
+
+// Enable or disable the serial port, releasing the RB5 and RB7 pins when off.
+void EUSART_enable(bool enable)
+{
+    if(!enable)
+    {
+        while(!EUSART_tx_idle())    // Wait for queued data
+            ;
+        while(!TRMT)                // Wait for the last character to be sent
+            ;
+    }
+    SPEN = enable;
+}
+
+// Enable or disable the interrupt-driven receiver.
+void EUSART_rx_enable(bool enable)
+{
+    RCIE = 0;
+    CREN = 0;                   // Turning CREN off also clears overrun errors
+    if(enable)
+    {
+        rxRingTail = rxRingHead;    // Discard old received characters
+        CREN = 1;
+        RCIE = 1;
+    }
+}
+
+// Queue a caller-owned buffer for transmission without copying it.
+bool EUSART_write(const unsigned char *buf, unsigned char len)
+{
+    unsigned char entry;
+
+    if(len == 0)
+    {
+        return (true);
+    }
+    TXIE = 0;                   // Hold off EUSART_isr() while queueing
+    if((unsigned char)(txQueueHead - txQueueTail) == EUSART_TX_QUEUE_SIZE)
+    {
+        TXIE = 1;               // Queue is full, and therefore not idle
+        return (false);
+    }
+    entry = txQueueHead & TX_QUEUE_MASK;
+    txQueueStart[entry] = buf;
+    txQueuePtr[entry] = buf;
+    txQueueLen[entry] = len;
+    txQueueRing[entry] = false;
+    txQueueHead++;
+    TXIE = 1;                   // Start (or continue) transmitting
+    return (true);
+}
+
+// Return true if the buffer starting at buf is still queued or being sent.
+bool EUSART_tx_pending(const unsigned char *buf)
+{
+    unsigned char i;
+
+    for(i = txQueueTail; i != txQueueHead; i++)
+    {
+        if(txQueueStart[i & TX_QUEUE_MASK] == buf && !txQueueRing[i & TX_QUEUE_MASK])
+        {
+            return (true);
+        }
+    }
+    return (false);
+}
+
+// Return true when all queued data has been moved to the EUSART.
+bool EUSART_tx_idle(void)
+{
+    return (txQueueTail == txQueueHead);
+}
+
+// Copy characters into the transmit ring buffer, extending the last queued
+// ring segment if it is still open, and queueing a new segment otherwise. Must
+// be called with TXIE = 0. Returns the number of characters copied.
+static unsigned char tx_ring_append(const unsigned char *src, unsigned char len)
+{
+    unsigned char count = 0;
+    unsigned char index;
+    unsigned char last;
+
+    while(count != len)
+    {
+        if((unsigned char)(txRingHead - txRingTail) == EUSART_TX_RING_SIZE)
+        {
+            break;              // Ring buffer full, drop remaining characters
+        }
+        index = txRingHead & TX_RING_MASK;
+        last = (txQueueHead - 1) & TX_QUEUE_MASK;
+        // A segment can only be extended while it is still queued, is the last
+        // entry, and the next character is contiguous with it in the ring.
+        if(txQueueHead != txQueueTail && txQueueRing[last] && index != 0)
+        {
+            txQueueLen[last]++;
+        }
+        else
+        {
+            if((unsigned char)(txQueueHead - txQueueTail) == EUSART_TX_QUEUE_SIZE)
+            {
+                break;          // Queue full, drop remaining characters
+            }
+            last = txQueueHead & TX_QUEUE_MASK;
+            txQueueStart[last] = &txRing[index];
+            txQueuePtr[last] = &txRing[index];
+            txQueueLen[last] = 1;
+            txQueueRing[last] = true;
+            txQueueHead++;
+        }
+        txRing[index] = src[count];
+        txRingHead++;
+        count++;
+    }
+    return (count);
+}
+
+// Copy characters into the transmit ring buffer and start transmitting.
+static unsigned char tx_copy(const unsigned char *src, unsigned char len)
+{
+    TXIE = 0;                   // Hold off EUSART_isr() while queueing
+    len = tx_ring_append(src, len);
+    if(txQueueHead != txQueueTail)
+    {
+        TXIE = 1;               // Start (or continue) transmitting
+    }
+    return (len);
+}
+
+// Copy one character into the transmit ring buffer.
+bool EUSART_putc(unsigned char c)
+{
+    return (tx_copy(&c, 1) == 1);
+}
+
+// Copy a zero-terminated string into the transmit ring buffer.
+void EUSART_print(const char *str)
+{
+    while(*str != 0)
+    {
+        if(!EUSART_putc((unsigned char)*str))
+        {
+            return;
+        }
+        str++;
+    }
+}
+
+// Format value as two hexadecimal digits.
+void EUSART_print_hex8(unsigned char value)
+{
+    unsigned char digits[2];
+
+    digits[0] = hexDigits[value >> 4];
+    digits[1] = hexDigits[value & 0x0F];
+    tx_copy(digits, 2);
+}
+
+// Format value as two hexadecimal digits in a caller-owned buffer.
+void EUSART_format_hex8(unsigned char *dest, unsigned char value)
+{
+    dest[0] = hexDigits[value >> 4];
+    dest[1] = hexDigits[value & 0x0F];
+}
+
+// Format value as an unsigned decimal number using repeated subtraction.
+void EUSART_print_u8(unsigned char value)
+{
+    unsigned char digits[3];
+    unsigned char count = 0;
+    unsigned char digit;
+
+    if(value >= 200)
+    {
+        value -= 200;
+        digits[count++] = '2';
+    }
+    else if(value >= 100)
+    {
+        value -= 100;
+        digits[count++] = '1';
+    }
+    digit = '0';
+    while(value >= 10)
+    {
+        value -= 10;
+        digit++;
+    }
+    if(count != 0 || digit != '0')
+    {
+        digits[count++] = digit;
+    }
+    digits[count++] = '0' + value;
+    tx_copy(digits, count);
+}
+
+// Format value as an unsigned decimal number using repeated subtraction.
+void EUSART_print_u16(unsigned int value)
+{
+    static const unsigned int powers[4] = {10000, 1000, 100, 10};
+    unsigned char digits[5];
+    unsigned char count = 0;
+    unsigned char digit;
+    unsigned char i;
+
+    for(i = 0; i != 4; i++)
+    {
+        digit = '0';
+        while(value >= powers[i])
+        {
+            value -= powers[i];
+            digit++;
+        }
+        if(count != 0 || digit != '0')
+        {
+            digits[count++] = digit;
+        }
+    }
+    digits[count++] = '0' + (unsigned char)value;
+    tx_copy(digits, count);
+}
+
+// Format value as an unsigned decimal number using repeated subtraction.
+void EUSART_print_u32(uint32_t value)
+{
+    static const uint32_t powers[9] = {1000000000, 100000000, 10000000,
+        1000000, 100000, 10000, 1000, 100, 10};
+    unsigned char digits[10];
+    unsigned char count = 0;
+    unsigned char digit;
+    unsigned char i;
+
+    for(i = 0; i != 9; i++)
+    {
+        digit = '0';
+        while(value >= powers[i])
+        {
+            value -= powers[i];
+            digit++;
+        }
+        if(count != 0 || digit != '0')
+        {
+            digits[count++] = digit;
+        }
+    }
+    digits[count++] = '0' + (unsigned char)value;
+    tx_copy(digits, count);
+}
+
+// Wait for the transmit queue to empty, then copy a string. Reports are not
+// time-critical, and waiting first means their short items are never dropped.
+void EUSART_report(const char *str)
+{
+    while(!EUSART_tx_idle())
+        ;
+    EUSART_print(str);
+}
+
+// Wait for the transmit queue to empty, then format a space and a number.
+void EUSART_report_u32(uint32_t value)
+{
+    while(!EUSART_tx_idle())
+        ;
+    EUSART_putc(' ');
+    EUSART_print_u32(value);
+}
+
+// Return the number of received characters waiting in the receive buffer.
+unsigned char EUSART_rx_count(void)
+{
+    return ((unsigned char)(rxRingHead - rxRingTail));
+}
+
+// Return the next received character, or 0 if the receive buffer is empty.
+unsigned char EUSART_getc(void)
+{
+    unsigned char c;
+
+    if(rxRingHead == rxRingTail)
+    {
+        return (0);
+    }
+    c = rxRing[rxRingTail & RX_RING_MASK];
+    rxRingTail++;
+    return (c);
+}
+
+// EUSART transmit and receive interrupt handler (call from the ISR).
+void EUSART_isr(void)
+{
+    unsigned char entry;
+    unsigned char c;
+
+    // Receive: store characters until the receive buffer is full.
+    if(RCIE && RCIF)
+    {
+        if(OERR)
+        {
+            CREN = 0;           // Clear overrun error by resetting receiver
+            CREN = 1;
+        }
+        if(FERR)
+        {
+            c = RCREG;          // Discard framing errors (eg. SW3 presses)
+        }
+        else
+        {
+            c = RCREG;          // Reading RCREG clears RCIF
+            if((unsigned char)(rxRingHead - rxRingTail) != EUSART_RX_RING_SIZE)
+            {
+                rxRing[rxRingHead & RX_RING_MASK] = c;
+                rxRingHead++;
+            }
+        }
+    }
+
+    // Transmit: TXREG and the transmit shift register are both empty when
+    // transmission starts, so up to two characters can be loaded at once.
+    while(TXIE && TXIF)
+    {
+        if(txQueueTail == txQueueHead)
+        {
+            TXIE = 0;           // Nothing left to send
+            return;
+        }
+        entry = txQueueTail & TX_QUEUE_MASK;
+        TXREG = *txQueuePtr[entry];
+        txQueuePtr[entry]++;
+        if(txQueueRing[entry])
+        {
+            txRingTail++;       // Free the ring buffer location
+        }
+        txQueueLen[entry]--;
+        if(txQueueLen[entry] == 0)
+        {
+            txQueueTail++;
+        }
+    }
+}
@@ -0,0 +1,231 @@
+/*==============================================================================
+ File: EUSART.h
+ Date: October 18, 2026
+
+ UBMP4.1 (PIC16F1459) buffered EUSART serial driver constant definitions and
+ function prototypes
+
+ Pin usage:
+ The PIC16F1459 EUSART transmits on RB7 (SW5) and receives on RB5 (SW3). While
+ the transmitter is enabled, RB7 is driven by the EUSART, so SW5 must not be
+ pressed (connect a 3.3V/5V USB-serial adapter RX input to the SW5 side of the
+ pushbutton). The receiver is optional - SW3 can still be read as a pushbutton
+ input while the receiver is enabled. SW3 presses look like break characters
+ to the receiver, and characters with framing errors are discarded.
+
+ Transmit operation:
+ Two kinds of data can be queued for transmission, and are sent in the same
+ order they were queued:
+ - caller-owned buffers (EUSART_write), which are queued by reference and are
+   NOT copied. The buffer must not be changed until EUSART_tx_pending() returns
+   false for it.
+ - characters and formatted numbers (EUSART_putc, EUSART_print_...), which are
+   copied into a small internal transmit ring buffer.
+ All transmit functions return immediately without waiting for the EUSART. The
+ interrupt service routine calls EUSART_isr() to move data into TXREG.
+
+ Formatter:
+ The number formatting functions are integer-only and convert values using
+ repeated subtraction and nibble look-ups, avoiding the code size of printf()
+ and the cycle cost of XC8 software division. Estimated worst-case main loop
+ cost at 48 MHz (12 MIPS), from the number of operations in each function (not
+ measured - time them on a built image by toggling a spare pin around a call):
+   EUSART_putc()          2 us
+   EUSART_print_hex8()    3 us
+   EUSART_format_hex8()   1 us  (with EUSART_write(), for time-critical loops)
+   EUSART_print_u8()      8 us  (value 199)
+   EUSART_print_u16()     35 us (value 59999)
+   EUSART_write()         3 us  (independent of buffer length)
+ EUSART_isr() is estimated to run for about 3 us per transmitted byte, which is
+ about 30% of the CPU at 1 Mbaud, or 3.5% at 115200 baud.
+==============================================================================*/
+
+// EUSART baud rate generator (SPBRG) values for EUSART_config(). Calculated for
+// 48 MHz Fosc, BRGH = 1, BRG16 = 1: SPBRG = (Fosc / (4 * baud)) - 1
+#define BAUD_9600       1249        // 9600 baud (0.00% error)
+#define BAUD_19200      624         // 19200 baud (0.00% error)
+#define BAUD_57600      207         // 57600 baud (0.16% error)
+#define BAUD_115200     103         // 115200 baud (0.16% error)
+#define BAUD_250000     47          // 250 kbaud (0.00% error)
+#define BAUD_500000     23          // 500 kbaud (0.00% error)
+#define BAUD_1000000    11          // 1 Mbaud (0.00% error)
+#define BAUD_3000000    3           // 3 Mbaud (0.00% error)
+
+// EUSART buffer sizes. Ring buffer sizes must be a power of 2.
+#define EUSART_TX_RING_SIZE 32      // Transmit ring buffer size (bytes)
+#define EUSART_RX_RING_SIZE 16      // Receive ring buffer size (bytes)
+#define EUSART_TX_QUEUE_SIZE 4      // Transmit queue size (buffers + segments)
+
+// Prototypes for EUSART.c functions:
+
+/**
+ * Function: void EUSART_config(unsigned int brg)
+ *
+ * Configure the EUSART for asynchronous 8N1 operation at the baud rate set by
+ * the specified baud rate constant, enable the transmitter and the peripheral
+ * interrupts. The receiver is left off (see EUSART_rx_enable()).
+ *
+ * Example usage: EUSART_config(BAUD_115200);
+ */
+void EUSART_config(unsigned int);
+
+/**
+ * Function: void EUSART_enable(bool enable)
+ *
+ * Enable or disable the serial port. Disabling waits for queued data to be
+ * sent, and then returns the RB5 and RB7 pins to pushbutton inputs so that
+ * SW3 and SW5 can be used between serial reports.
+ *
+ * Example usage: EUSART_enable(false);
+ */
+void EUSART_enable(bool);
+
+/**
+ * Function: void EUSART_rx_enable(bool enable)
+ *
+ * Enable or disable the interrupt-driven receiver on RB5 (SW3).
+ *
+ * Example usage: EUSART_rx_enable(true);
+ */
+void EUSART_rx_enable(bool);
+
+/**
+ * Function: bool EUSART_write(const unsigned char *buf, unsigned char len)
+ *
+ * Queue a caller-owned buffer for transmission without copying it. Returns
+ * false (and queues nothing) if the transmit queue is full.
+ *
+ * Example usage: EUSART_write(message, sizeof(message));
+ */
+bool EUSART_write(const unsigned char *, unsigned char);
+
+/**
+ * Function: bool EUSART_tx_pending(const unsigned char *buf)
+ *
+ * Return true if the buffer starting at buf is still queued or being sent.
+ *
+ * Example usage: while(EUSART_tx_pending(message));
+ */
+bool EUSART_tx_pending(const unsigned char *);
+
+/**
+ * Function: bool EUSART_tx_idle(void)
+ *
+ * Return true when all queued data has been moved to the EUSART.
+ */
+bool EUSART_tx_idle(void);
+
+/**
+ * Function: bool EUSART_putc(unsigned char c)
+ *
+ * Copy one character into the transmit ring buffer. Returns false (and drops
+ * the character) if the ring buffer or transmit queue is full.
+ *
+ * Example usage: EUSART_putc('\n');
+ */
+bool EUSART_putc(unsigned char);
+
+/**
+ * Function: void EUSART_print(const char *str)
+ *
+ * Copy a zero-terminated string into the transmit ring buffer. Use
+ * EUSART_write() for long or constant messages to avoid copying.
+ *
+ * Example usage: EUSART_print("SW2Count=");
+ */
+void EUSART_print(const char *);
+
+/**
+ * Function: void EUSART_print_hex8(unsigned char value)
+ *
+ * Format value as two upper case hexadecimal digits.
+ *
+ * Example usage: EUSART_print_hex8(SW2Count);
+ */
+void EUSART_print_hex8(unsigned char);
+
+/**
+ * Function: void EUSART_format_hex8(unsigned char *dest, unsigned char value)
+ *
+ * Write value as two upper case hexadecimal digits into dest, without
+ * queueing them. Use this to update a caller-owned message buffer that is sent
+ * with a single EUSART_write(), after checking that the buffer is no longer
+ * being sent (eg. EUSART_tx_idle() returns true).
+ *
+ * Example usage: EUSART_format_hex8(&countLog[9], SW2Count);
+ */
+void EUSART_format_hex8(unsigned char *, unsigned char);
+
+/**
+ * Function: void EUSART_print_u8(unsigned char value)
+ *
+ * Format value as an unsigned decimal number without leading zeros.
+ *
+ * Example usage: EUSART_print_u8(SW2Count);
+ */
+void EUSART_print_u8(unsigned char);
+
+/**
+ * Function: void EUSART_print_u16(unsigned int value)
+ *
+ * Format value as an unsigned decimal number without leading zeros.
+ *
+ * Example usage: EUSART_print_u16(lightLevel);
+ */
+void EUSART_print_u16(unsigned int);
+
+/**
+ * Function: void EUSART_print_u32(uint32_t value)
+ *
+ * Format value as an unsigned decimal number without leading zeros. This is
+ * slower than EUSART_print_u16() and is intended for reports.
+ *
+ * Example usage: EUSART_print_u32(reactionTime);
+ */
+void EUSART_print_u32(uint32_t);
+
+/**
+ * Function: void EUSART_report(const char *str)
+ *
+ * Wait until all queued data has been moved to the EUSART, then copy a
+ * zero-terminated string into the transmit ring buffer. Waiting means report
+ * items are never dropped, but this blocks the main loop - use it for reports
+ * and not in time-critical loops.
+ *
+ * Example usage: EUSART_report("Round");
+ */
+void EUSART_report(const char *);
+
+/**
+ * Function: void EUSART_report_u32(uint32_t value)
+ *
+ * Wait like EUSART_report(), then send a space followed by value as an
+ * unsigned decimal number.
+ *
+ * Example usage: EUSART_report_u32(reactionTime);
+ */
+void EUSART_report_u32(uint32_t);
+
+/**
+ * Function: unsigned char EUSART_rx_count(void)
+ *
+ * Return the number of received characters waiting in the receive buffer.
+ */
+unsigned char EUSART_rx_count(void);
+
+/**
+ * Function: unsigned char EUSART_getc(void)
+ *
+ * Return the next received character, or 0 if the receive buffer is empty.
+ *
+ * Example usage: if(EUSART_rx_count() != 0) command = EUSART_getc();
+ */
+unsigned char EUSART_getc(void);
+
+/**
+ * Function: void EUSART_isr(void)
+ *
+ * EUSART transmit and receive interrupt handler. Call this function from the
+ * main program's interrupt service routine.
+ */
+void EUSART_isr(void);
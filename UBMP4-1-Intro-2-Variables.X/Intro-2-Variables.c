@@ -17,22 +17,99 @@
 #include    "stdbool.h"         // Include Boolean (true/false) definitions
 
 #include    "UBMP410.h"         // Include UBMP4.1 constant and function definitions
+#include    "EUSART.h"          // Include EUSART serial driver definitions
+#include    "TOUCH.h"           // Include capacitive touch sensing definitions
+#include    "TIMEBASE.h"        // Include timestamp timer definitions
+#include    "USB_HID.h"         // Include USB HID keyboard/gamepad definitions
+#include    "REACTION.h"        // Include reaction-time game definitions
+#include    "OPTICAL.h"         // Include optical data link definitions
+#include    "SYNCBUS.h"         // Include multi-board sync bus definitions
 
 // TODO Set linker ROM ranges to 'default,-0-7FF' under "Memory model" pull-down.
 // TODO Set linker code offset to '800' under "Additional options" pull-down.
 
+// Start-up modes built into the program. XC8 leaves out functions that are
+// never called, so setting a mode to 0 removes its code and RAM if the program
+// doesn't fit in the program memory (6K words after the bootloader) or RAM.
+#define REACTION_MODE   1       // SW2: reaction-time game (REACTION.c)
+#define USB_HID_MODE    1       // SW4: USB HID gamepad (USB_HID.c)
+#define OPTICAL_MODE    1       // SW3: optical link BER test (OPTICAL.c)
+#define SYNCBUS_MODE    1       // SW5: multi-board sync bus (SYNCBUS.c, SYNCMSG.c)
+
 // Program constant definitions
 const unsigned char maxCount = 50;
 
+// Serial log message (count digits are updated in place, and the whole line is
+// sent from RAM without copying)
+unsigned char countLog[] = "SW2Count=00\r\n";
+
 // Program variable definitions
 unsigned char SW2Count = 0;
 bool SW2Pressed = false;
+unsigned char loggedCount = 0;
+
+// Interrupt service routine. Serial data, touch keys, the timebase, USB, the
+// optical link and the sync bus are all handled in the background. The sync bus
+// is handled first to keep its clock edge timestamps accurate.
+void __interrupt() isr(void)
+{
+#if SYNCBUS_MODE
+    SYNCBUS_isr();
+#endif
+    EUSART_isr();
+    TOUCH_isr();
+    TIMEBASE_isr();
+#if USB_HID_MODE
+    USB_HID_isr();
+#endif
+#if REACTION_MODE
+    REACTION_isr();
+#endif
+#if OPTICAL_MODE
+    OPTICAL_isr();
+#endif
+}
 
 int main(void)
 {
     // Configure oscillator and I/O ports. These functions run once at start-up.
     OSC_config();               // Configure internal oscillator for 48 MHz
     UBMP4_config();             // Configure on-board UBMP4 I/O devices
+    
+#if REACTION_MODE
+    // Hold SW2 while connecting UBMP4 to run the reaction-time game instead.
+    if(SW2 == 0)
+    {
+        REACTION_mode();        // Does not return
+    }
+#endif
+    
+#if USB_HID_MODE
+    // Hold SW4 while connecting UBMP4 to run as a USB HID gamepad instead.
+    if(SW4 == 0)
+    {
+        USB_HID_mode();         // Does not return
+    }
+#endif
+    
+#if OPTICAL_MODE
+    // Hold SW3 while connecting UBMP4 to run the optical link BER test instead.
+    if(SW3 == 0)
+    {
+        OPTICAL_mode();         // Does not return
+    }
+#endif
+    
+#if SYNCBUS_MODE
+    // Hold SW5 while connecting UBMP4 to join a multi-board sync bus instead.
+    if(SW5 == 0)
+    {
+        SYNCBUS_mode();         // Does not return
+    }
+#endif
+    
+    // EUSART_config(BAUD_115200);   // Uncomment to log SW2Count on RB7 (SW5 can't be used)
+    // TOUCH_config(TOUCH_H1 | TOUCH_H2);  // Uncomment to add H1/H2 touch keys
 	
     // Code in this while loop runs repeatedly.
     while(1)
@@ -60,6 +137,18 @@ int main(void)
             SW2Count = 0;
         }
         
+        // Log count changes in hexadecimal if the serial port is enabled. The
+        // log line is only updated once the previous one has been sent, and
+        // logging is estimated to add about 5 us to the main loop (EUSART.h).
+        if(SPEN && SW2Count != loggedCount && EUSART_tx_idle())
+        {
+            EUSART_format_hex8(&countLog[9], SW2Count);
+            if(EUSART_write(countLog, sizeof(countLog) - 1))
+            {
+                loggedCount = SW2Count;
+            }
+        }
+        
         // Add a short delay to the main while loop.
         __delay_ms(10);
         
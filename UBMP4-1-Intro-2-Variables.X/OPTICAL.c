@@ -0,0 +1,467 @@
+/*==============================================================================
+ File: OPTICAL.c
+ Date: October 18, 2026
+
+ UBMP4.1 (PIC16F1459) Manchester-encoded visible-light data link using LED D4
+ as the transmitter and phototransistor Q1 as the receiver
+
+ Clock recovery uses the time since the last mid-bit transition: transitions
+ less than 3/4 of a bit time after it are boundary transitions between equal
+ bits and are ignored, and the next transition is the middle of the next bit.
+ Include OPTICAL.h in your main program to call these functions.
+==============================================================================*/
+
+#include    "xc.h"              // XC compiler general include file
+
+#include    "stdint.h"          // Include integer definitions
+#include    "stdbool.h"         // Include Boolean (true/false) definitions
+
+#include    "UBMP410.h"         // Include UBMP4.1 constant and function definitions
+#include    "TIMEBASE.h"        // Include timebase constant and function definitions
+#include    "EUSART.h"          // Include EUSART constant and function definitions
+#include    "CRC8.h"            // Include CRC-8 function definitions
+#include    "OPTICAL.h"         // Include optical link constant and function definitions
+
+// Frame constants
+#define SYNC_WORD       0x2DD4      // Sync word following the preamble
+#define FRAME_HEADER    4           // Preamble and sync word bytes
+#define FRAME_OVERHEAD  (FRAME_HEADER + 2)  // Header, length and CRC bytes
+
+// Clock recovery limits (in samples since the last mid-bit transition)
+#define MID_BIT_MIN     (OPTICAL_SAMPLES_PER_BIT * 3 / 4)   // Next bit's middle
+#define CARRIER_LOST    (OPTICAL_SAMPLES_PER_BIT * 2)       // No transitions
+
+#define REPORT_TICKS    (1000UL * TIMEBASE_TICKS_PER_MS)    // BER report interval
+
+// Receiver states
+#define RX_HUNT         0           // Looking for the sync word
+#define RX_LENGTH       1           // Receiving the length byte
+#define RX_DATA         2           // Receiving payload and CRC bytes
+
+bool opticalActive = false;         // Optical link owns Timer2
+
+// Adaptive threshold: peak and valley trackers (8.8 fixed-point ADC values)
+unsigned int rxPeak = 0;
+unsigned int rxValley = 0;
+bool rxLevel = false;               // Current light (true) or dark level
+
+// Clock recovery and framing
+unsigned char rxSamples = 0;        // Samples since the last mid-bit transition
+unsigned char rxState = RX_HUNT;
+uint16_t rxShift = 0;               // Last 16 received bits (sync detection)
+bool rxInvert = false;              // Received signal is inverted
+unsigned char rxBits = 0;           // Bits received in the current byte
+unsigned char rxByte = 0;
+unsigned char rxIndex = 0;          // Bytes received after the length byte
+unsigned char rxFrame[OPTICAL_MAX_PAYLOAD + 2]; // Length, payload and CRC
+volatile bool rxReady = false;      // A frame is waiting in rxFrame
+volatile unsigned char rxOverruns = 0;  // Frames lost while rxFrame was full
+
+// Transmitter
+unsigned char txFrame[OPTICAL_MAX_PAYLOAD + FRAME_OVERHEAD];
+unsigned char txLength = 0;
+unsigned char txIndex = 0;
+unsigned char txByte = 0;
+unsigned char txMask = 0;
+unsigned char txTicks = 0;
+bool txSecondHalf = false;
+volatile bool txActive = false;
+
+// BER test results
+uint32_t berBits = 0;               // Payload bits compared
+uint32_t berErrors = 0;             // Payload bit errors
+unsigned int berGoodBits = 0;       // Good frame payload bits this interval
+unsigned int berFrames = 0;         // Frames received with a good CRC
+unsigned int berBadFrames = 0;      // Frames received with a bad CRC
+unsigned int berLostFrames = 0;     // Frames missing from the sequence
+unsigned char berNextSequence = 0;  // Expected next frame number
+bool berSynced = false;             // A frame number has been received
+
+// Configure the ADC, Timer2 and transmit LED, and start the receiver.
+void OPTICAL_config(void)
+{
+    ADC_config();               // 8-bit conversions of Q1 (AN7)
+    ADC_select_channel(ANQ1);
+    OPTICAL_LED = 0;
+    txActive = false;
+    rxState = RX_HUNT;
+    rxReady = false;
+    opticalActive = true;
+    GO = 1;                     // First conversion, read by the first interrupt
+
+    // Timer2: 12 MHz / 4 prescaler / (OPTICAL_PR2 + 1) = sample rate
+    PR2 = (unsigned char)OPTICAL_PR2;
+    TMR2 = 0;
+    T2CON = 0b00000101;         // 1:1 postscaler, Timer2 on, 1:4 prescaler
+    TMR2IF = 0;
+    TMR2IE = 1;
+    PEIE = 1;                   // Enable peripheral interrupts
+    GIE = 1;                    // Enable global interrupts
+}
+
+// Start sending a frame.
+bool OPTICAL_send(const unsigned char *data, unsigned char length)
+{
+    unsigned char i;
+
+    if(txActive || length == 0 || length > OPTICAL_MAX_PAYLOAD)
+    {
+        return (false);
+    }
+    txFrame[0] = 0x55;
+    txFrame[1] = 0x55;
+    txFrame[2] = (unsigned char)(SYNC_WORD >> 8);
+    txFrame[3] = (unsigned char)SYNC_WORD;
+    txFrame[4] = length;
+    for(i = 0; i != length; i++)
+    {
+        txFrame[FRAME_HEADER + 1 + i] = data[i];
+    }
+    txFrame[FRAME_HEADER + 1 + length] = CRC8_calc(&txFrame[FRAME_HEADER], length + 1);
+    txLength = length + FRAME_OVERHEAD;
+    txIndex = 0;
+    txByte = txFrame[0];
+    txMask = 0b10000000;
+    txSecondHalf = false;
+    txTicks = OPTICAL_SAMPLES_PER_BIT / 2 - 1;  // First bit starts next sample
+    txActive = true;
+    return (true);
+}
+
+// Return true while a frame is being sent.
+bool OPTICAL_tx_busy(void)
+{
+    return (txActive);
+}
+
+// Copy the last received frame if its CRC is good, and return its length.
+unsigned char OPTICAL_receive(unsigned char *data)
+{
+    unsigned char length;
+    unsigned char i;
+
+    if(!rxReady)
+    {
+        return (0);
+    }
+    length = rxFrame[0];
+    if(CRC8_calc(rxFrame, length + 1) != rxFrame[length + 1])
+    {
+        length = 0;
+    }
+    for(i = 0; i != length; i++)
+    {
+        data[i] = rxFrame[i + 1];
+    }
+    rxReady = false;
+    return (length);
+}
+
+// Fill a BER test payload with the pseudo-random sequence for a frame number.
+// The first byte is the frame number, followed by 8-bit Galois LFSR output.
+static void ber_payload(unsigned char *data, unsigned char sequence)
+{
+    unsigned char lfsr = sequence | 0x01;   // Never zero
+    unsigned char i;
+
+    data[0] = sequence;
+    for(i = 1; i != OPTICAL_BER_PAYLOAD; i++)
+    {
+        lfsr = (lfsr & 1) ? (lfsr >> 1) ^ 0xB8 : (lfsr >> 1);
+        data[i] = lfsr;
+    }
+}
+
+// Check a received test frame and update the BER test results. Payload bits
+// are compared even if the CRC is bad, as long as the frame number is good.
+static void ber_check(void)
+{
+    unsigned char expected[OPTICAL_BER_PAYLOAD];
+    unsigned char errors;
+    unsigned char i;
+    bool crcGood;
+
+    crcGood = (rxFrame[0] == OPTICAL_BER_PAYLOAD &&
+            CRC8_calc(rxFrame, OPTICAL_BER_PAYLOAD + 1) == rxFrame[OPTICAL_BER_PAYLOAD + 1]);
+    if(!crcGood)
+    {
+        berBadFrames++;
+        LED6 = !LED6;
+    }
+    else
+    {
+        berFrames++;
+        berGoodBits += OPTICAL_BER_PAYLOAD * 8;
+        LED5 = !LED5;
+        if(berSynced)
+        {
+            berLostFrames += (unsigned char)(rxFrame[1] - berNextSequence);
+        }
+        berNextSequence = rxFrame[1] + 1;
+        berSynced = true;
+    }
+    if(rxFrame[0] != OPTICAL_BER_PAYLOAD || (!crcGood && !berSynced))
+    {
+        rxReady = false;        // Frame number can't be trusted
+        return;
+    }
+    ber_payload(expected, crcGood ? rxFrame[1] : berNextSequence++);
+    for(i = 1; i != OPTICAL_BER_PAYLOAD; i++)
+    {
+        errors = rxFrame[i + 1] ^ expected[i];
+        while(errors != 0)
+        {
+            berErrors++;
+            errors &= errors - 1;   // Clear lowest set bit
+        }
+    }
+    berBits += (OPTICAL_BER_PAYLOAD - 1) * 8;
+    rxReady = false;
+}
+
+// Clear the BER test results.
+static void ber_clear(void)
+{
+    berBits = 0;
+    berErrors = 0;
+    berGoodBits = 0;
+    berFrames = 0;
+    berBadFrames = 0;
+    berLostFrames = 0;
+    berSynced = false;
+    rxOverruns = 0;
+}
+
+// Report the BER test results on the serial port. The bit rate is the measured
+// throughput: payload bits in good frames during the last report interval.
+static void ber_report(void)
+{
+    EUSART_report("bps");
+    EUSART_report_u32(berGoodBits);
+    berGoodBits = 0;
+    EUSART_report(" frames");
+    EUSART_report_u32(berFrames);
+    EUSART_report(" bad");
+    EUSART_report_u32(berBadFrames);
+    EUSART_report(" lost");
+    EUSART_report_u32(berLostFrames + rxOverruns);
+    EUSART_report(" bits");
+    EUSART_report_u32(berBits);
+    EUSART_report(" errors");
+    EUSART_report_u32(berErrors);
+    EUSART_report("\r\n");
+}
+
+// Run the optical link bit error rate test. This function does not return.
+void OPTICAL_mode(void)
+{
+    unsigned char payload[OPTICAL_BER_PAYLOAD];
+    unsigned char sequence = 0;
+    bool transmit = false;
+    bool SW2Pressed = false;
+    uint32_t SW2Time;
+    uint32_t reportTime;
+
+    TIMEBASE_config();
+    EUSART_config(BAUD_115200);
+    OPTICAL_config();
+    ber_clear();
+    reportTime = TIMEBASE_ticks();
+    SW2Time = reportTime;
+
+    while(1)
+    {
+        // SW2 turns the test transmitter on and off. Changes within
+        // TIMEBASE_DEBOUNCE_TICKS of the last accepted change are contact bounce.
+        if((SW2 == 0) != SW2Pressed && TIMEBASE_ticks() - SW2Time >= TIMEBASE_DEBOUNCE_TICKS)
+        {
+            SW2Pressed = !SW2Pressed;
+            SW2Time = TIMEBASE_ticks();
+            if(SW2Pressed)
+            {
+                transmit = !transmit;
+                LED3 = transmit;
+            }
+        }
+
+        // SW4 clears the results.
+        if(SW4 == 0)
+        {
+            ber_clear();
+        }
+
+        if(transmit && !txActive)
+        {
+            ber_payload(payload, sequence++);
+            OPTICAL_send(payload, OPTICAL_BER_PAYLOAD);
+        }
+
+        if(rxReady)
+        {
+            ber_check();
+        }
+
+        if(TIMEBASE_ticks() - reportTime >= REPORT_TICKS)
+        {
+            reportTime += REPORT_TICKS;
+            ber_report();
+        }
+
+        // Activate bootloader if SW1 is pressed.
+        if(SW1 == 0)
+        {
+            RESET();
+        }
+    }
+}
+
+// Receive one Manchester-decoded bit.
+static void optical_rx_bit(bool bit)
+{
+    rxShift = (rxShift << 1) | bit;
+    if(rxState == RX_HUNT)
+    {
+        if(rxShift == SYNC_WORD || rxShift == (uint16_t)~SYNC_WORD)
+        {
+            rxInvert = (rxShift != SYNC_WORD);
+            rxState = RX_LENGTH;
+            rxBits = 0;
+        }
+        return;
+    }
+
+    rxByte = (rxByte << 1) | (bit ^ rxInvert);
+    if(++rxBits != 8)
+    {
+        return;
+    }
+    rxBits = 0;
+    if(rxState == RX_LENGTH)
+    {
+        if(rxByte == 0 || rxByte > OPTICAL_MAX_PAYLOAD || rxReady)
+        {
+            if(rxReady)
+            {
+                rxOverruns++;   // Previous frame has not been read yet
+            }
+            rxState = RX_HUNT;
+            rxShift = 0;
+            return;
+        }
+        rxFrame[0] = rxByte;
+        rxIndex = 1;
+        rxState = RX_DATA;
+        return;
+    }
+    rxFrame[rxIndex] = rxByte;
+    if(rxIndex == rxFrame[0] + 1)
+    {
+        rxReady = true;         // Payload and CRC received
+        rxState = RX_HUNT;
+        rxShift = 0;
+    }
+    rxIndex++;
+}
+
+// Sampling, receiver and transmitter interrupt handler (call from the ISR).
+void OPTICAL_isr(void)
+{
+    unsigned char sample;
+    unsigned char threshold;
+    unsigned char hysteresis;
+    unsigned int level;
+    bool txBit;
+
+    if(!(opticalActive && TMR2IE && TMR2IF))
+    {
+        return;
+    }
+    TMR2IF = 0;
+
+    // Transmitter: output one half-bit every OPTICAL_SAMPLES_PER_BIT / 2 samples.
+    if(txActive && ++txTicks == OPTICAL_SAMPLES_PER_BIT / 2)
+    {
+        txTicks = 0;
+        txBit = (txByte & txMask) != 0;
+        if(!txSecondHalf)
+        {
+            if(txMask == 0)
+            {
+                txMask = 0b10000000;
+                if(++txIndex == txLength)
+                {
+                    txActive = false;   // Frame sent, LED is left off
+                    OPTICAL_LED = 0;
+                }
+                else
+                {
+                    txByte = txFrame[txIndex];
+                    txBit = (txByte & txMask) != 0;
+                }
+            }
+            if(txActive)
+            {
+                OPTICAL_LED = !txBit;   // 1: dark then light, 0: light then dark
+                txSecondHalf = true;
+            }
+        }
+        else
+        {
+            OPTICAL_LED = txBit;
+            txMask >>= 1;
+            txSecondHalf = false;
+        }
+    }
+
+    // Read the previous conversion and start the next one.
+    sample = ADRESH;
+    GO = 1;
+
+    // Track the light (peak) and dark (valley) levels.
+    level = (unsigned int)sample << 8;
+    if(level > rxPeak)
+    {
+        rxPeak = level;
+    }
+    else
+    {
+        rxPeak -= (rxPeak - rxValley) >> OPTICAL_DECAY_SHIFT;
+    }
+    if(level < rxValley)
+    {
+        rxValley = level;
+    }
+    else
+    {
+        rxValley += (rxPeak - rxValley) >> OPTICAL_DECAY_SHIFT;
+    }
+
+    // Count samples since the last mid-bit transition, and reset the receiver
+    // if there are no transitions (or not enough light/dark difference).
+    if(rxSamples != 255)
+    {
+        rxSamples++;
+    }
+    hysteresis = (unsigned char)((rxPeak - rxValley) >> 8);
+    if(hysteresis < OPTICAL_MIN_SWING || rxSamples > CARRIER_LOST)
+    {
+        rxState = RX_HUNT;
+        if(hysteresis < OPTICAL_MIN_SWING)
+        {
+            return;
+        }
+    }
+
+    // Compare with a threshold halfway between the peak and valley levels.
+    threshold = (unsigned char)((rxPeak >> 9) + (rxValley >> 9));
+    hysteresis >>= 4;           // Hysteresis is 1/16 of the light/dark difference
+    if(rxLevel ? (sample < threshold - hysteresis) : (sample > threshold + hysteresis))
+    {
+        rxLevel = !rxLevel;
+        if(rxSamples >= MID_BIT_MIN)
+        {
+            rxSamples = 0;      // Mid-bit transition: dark to light is a 1
+            optical_rx_bit(rxLevel);
+        }
+    }
+}
@@ -0,0 +1,121 @@
+/*==============================================================================
+ File: OPTICAL.h
+ Date: October 18, 2026
+
+ UBMP4.1 (PIC16F1459) visible-light data link constant definitions and
+ function prototypes
+
+ Operation:
+ Data frames are Manchester encoded (IEEE 802.3 convention - a 0 bit is sent
+ as light then dark, and a 1 bit as dark then light) and sent by switching LED
+ D4 (and IR LED D2, if installed). The receiving board samples phototransistor
+ Q1 with the ADC, and separates light from dark using a threshold halfway
+ between slowly decaying peak and valley trackers, so that it adapts to
+ ambient light and LED distance. The receiver locks on to the transition in
+ the middle of each bit, so no separate clock is needed, and detects inverted
+ signals from the polarity of the sync word.
+
+ Frame format (bytes are sent most significant bit first):
+   0x55 0x55        Preamble (alternating bits for the receiver to lock on)
+   0x2D 0xD4        Sync word
+   length           Payload length (1 - OPTICAL_MAX_PAYLOAD)
+   payload          Data bytes
+   CRC              CRC-8 (polynomial 0x07) of the length and payload
+
+ Sampling and bit rate:
+ Timer2 runs OPTICAL_isr() at the sample rate, which reads the previous ADC
+ conversion of Q1, starts the next one, and updates the transmitter. Each ADC
+ conversion takes 11.5 TAD (15.3 us at FOSC/64, the fastest valid ADC clock at
+ 48 MHz) plus acquisition time, limiting sampling to about 55 kHz, and the
+ interrupt handler needs about 10-15 us per sample. Timer2's 8-bit period
+ register sets the lowest sample rate, 11719 Hz (3 MHz / 256). The default
+ 20 kHz sample rate and 8 samples per bit give 2500 bits per second using
+ 20-30% of the CPU.
+ Setting OPTICAL_SAMPLE_RATE to 40000 gives 5000 bits per second using 40-60%
+ of the CPU, if the phototransistor response is fast enough - use the bit error
+ rate test to check each setting.
+
+ Bit error rate (BER) test:
+ OPTICAL_mode() sends numbered test frames with a pseudo-random payload when
+ its transmitter is on (SW2 toggles it), and checks every received test frame
+ against the same pseudo-random sequence. Results, including the measured
+ throughput (payload bits per second in frames with a good CRC), are reported
+ on the serial port (EUSART.c, 115200 baud) once per second.
+==============================================================================*/
+
+// Optical link settings
+#define OPTICAL_LED             LATCbits.LATC5  // Transmit LED (D4/D2 output)
+#define OPTICAL_SAMPLE_RATE     20000   // Sample rate (Hz, 11719 - 50000)
+#define OPTICAL_PR2             (3000000UL / OPTICAL_SAMPLE_RATE - 1)  // Timer2 period
+#define OPTICAL_SAMPLES_PER_BIT 8       // Samples per bit (even, at least 4)
+#define OPTICAL_MIN_SWING       12      // Minimum light/dark ADC difference
+#define OPTICAL_DECAY_SHIFT     10      // Peak tracker decay (2^10 samples)
+#define OPTICAL_MAX_PAYLOAD     32      // Largest frame payload (bytes)
+#define OPTICAL_BER_PAYLOAD     16      // BER test frame payload (bytes)
+#define OPTICAL_BIT_RATE        (OPTICAL_SAMPLE_RATE / OPTICAL_SAMPLES_PER_BIT)
+
+// Timer2's period register is 8 bits, and the ADC and interrupt handler limit
+// the highest sample rate.
+#if OPTICAL_SAMPLE_RATE < 11719 || OPTICAL_PR2 > 255
+#error "OPTICAL_SAMPLE_RATE is too low for Timer2 (at least 11719 Hz)"
+#endif
+#if OPTICAL_SAMPLE_RATE > 50000
+#error "OPTICAL_SAMPLE_RATE is too high (at most 50000 Hz)"
+#endif
+
+// Prototypes for OPTICAL.c functions:
+
+/**
+ * Function: void OPTICAL_config(void)
+ *
+ * Configure the ADC for Q1, Timer2 for the sample rate, and the transmit LED,
+ * and start the receiver.
+ */
+void OPTICAL_config(void);
+
+/**
+ * Function: bool OPTICAL_send(const unsigned char *data, unsigned char length)
+ *
+ * Start sending a frame containing length bytes of data. Returns false if the
+ * previous frame is still being sent or the length is invalid. The data is
+ * copied, so the buffer can be re-used immediately.
+ *
+ * Example usage: OPTICAL_send(message, 5);
+ */
+bool OPTICAL_send(const unsigned char *, unsigned char);
+
+/**
+ * Function: bool OPTICAL_tx_busy(void)
+ *
+ * Return true while a frame is being sent.
+ */
+bool OPTICAL_tx_busy(void);
+
+/**
+ * Function: unsigned char OPTICAL_receive(unsigned char *data)
+ *
+ * Copy the payload of the last received frame into data (which must hold
+ * OPTICAL_MAX_PAYLOAD bytes) and return its length, or return 0 if no frame
+ * has been received. Frames with CRC errors are discarded.
+ *
+ * Example usage: length = OPTICAL_receive(message);
+ */
+unsigned char OPTICAL_receive(unsigned char *);
+
+/**
+ * Function: void OPTICAL_mode(void)
+ *
+ * Run the optical link bit error rate test. SW2 turns the test transmitter on
+ * or off (LED D3 shows it is on), SW4 clears the results, and SW1 resets UBMP4
+ * into the bootloader. LED D5 flashes for each good frame, and LED D6 for each
+ * bad frame. This function does not return.
+ */
+void OPTICAL_mode(void);
+
+/**
+ * Function: void OPTICAL_isr(void)
+ *
+ * Sampling, receiver and transmitter interrupt handler. Call this function
+ * from the main program's interrupt service routine.
+ */
+void OPTICAL_isr(void);
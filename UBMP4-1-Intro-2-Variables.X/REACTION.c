@@ -0,0 +1,316 @@
+/*==============================================================================
+ File: REACTION.c
+ Date: October 18, 2026
+
+ UBMP4.1 (PIC16F1459) multi-player reaction-time game with microsecond timing
+
+ The interrupt-on-change handler records the first press of each player in
+ each round, and the main loop runs the rounds, updates the statistics, and
+ sends the reports. Include REACTION.h in your main program to call these
+ functions.
+==============================================================================*/
+
+#include    "xc.h"              // XC compiler general include file
+
+#include    "stdint.h"          // Include integer definitions
+#include    "stdbool.h"         // Include Boolean (true/false) definitions
+
+#include    "UBMP410.h"         // Include UBMP4.1 constant and function definitions
+#include    "TIMEBASE.h"        // Include timebase constant and function definitions
+#include    "EUSART.h"          // Include EUSART constant and function definitions
+#include    "REACTION.h"        // Include reaction game constant and function definitions
+
+// Player press state, written by REACTION_isr()
+bool reactionActive = false;        // Reaction mode owns the pushbutton interrupts
+volatile unsigned char reactionPressed = 0; // Players who pressed this round
+volatile uint32_t reactionPressTime[REACTION_PLAYERS];  // First press times
+
+// Game state
+REACTION_STATS reactionStats[REACTION_PLAYERS];
+unsigned int reactionRound = 0;
+unsigned int reactionRandom = 0xACE1;   // Random delay LFSR state
+
+// Light the LEDs (D3-D6) of the players in the players bit mask.
+static void reaction_leds(unsigned char players)
+{
+    LED3 = (players & 0b0001) ? 1 : 0;
+    LED4 = (players & 0b0010) ? 1 : 0;
+    LED5 = (players & 0b0100) ? 1 : 0;
+    LED6 = (players & 0b1000) ? 1 : 0;
+}
+
+// Wait for the specified time since start, resetting to the bootloader if SW1
+// is pressed.
+static void reaction_wait(uint32_t start, uint32_t ticks)
+{
+    while(TIMEBASE_ticks() - start < ticks)
+    {
+        if(SW1 == 0)
+        {
+            RESET();
+        }
+    }
+}
+
+// Return the next value of the 16-bit Galois LFSR random delay generator.
+static unsigned int reaction_random(void)
+{
+    if(reactionRandom & 1)
+    {
+        reactionRandom = (reactionRandom >> 1) ^ 0xB400;
+    }
+    else
+    {
+        reactionRandom >>= 1;
+    }
+    return (reactionRandom);
+}
+
+// Add a valid reaction time to a player's statistics.
+static void reaction_record(REACTION_STATS *stats, uint32_t us)
+{
+    uint32_t bin;
+
+    if(stats->count == 255)
+    {
+        return;                 // Keep the count and sum consistent
+    }
+    if(stats->count == 0 || us < stats->best)
+    {
+        stats->best = us;
+    }
+    stats->sum += us;
+    stats->count++;
+    bin = us >> REACTION_BIN_SHIFT;
+    if(bin >= REACTION_BINS)
+    {
+        bin = REACTION_BINS - 1;
+    }
+    if(stats->histogram[bin] != 255)
+    {
+        stats->histogram[bin]++;
+    }
+}
+
+// Send the round results and the statistics of all players.
+static void reaction_report(const uint32_t *times, unsigned char valid, unsigned char winners)
+{
+    REACTION_STATS *stats;
+    unsigned char p;
+    unsigned char bin;
+
+    EUSART_enable(true);
+    LED1 = 0;                   // Light D1 (active-low) while SW5 is serial TX
+    EUSART_report("Round");
+    EUSART_report_u32(reactionRound);
+    EUSART_report("\r\n");
+    for(p = 0; p != REACTION_PLAYERS; p++)
+    {
+        stats = &reactionStats[p];
+        EUSART_report("P");
+        EUSART_putc('1' + p);
+        if(valid & (1 << p))
+        {
+            EUSART_report_u32(times[p]);
+            EUSART_report(" us");
+            if(winners & (1 << p))
+            {
+                EUSART_report(" *");
+            }
+        }
+        else if(reactionPressed & (1 << p))
+        {
+            EUSART_report(" false start");
+        }
+        else
+        {
+            EUSART_report(" no press");
+        }
+        EUSART_report(", best");
+        EUSART_report_u32(stats->best);
+        EUSART_report(" mean");
+        EUSART_report_u32(REACTION_mean_us(p));
+        EUSART_report(" n");
+        EUSART_report_u32(stats->count);
+        EUSART_report(" false");
+        EUSART_report_u32(stats->falseStarts);
+        EUSART_report(" hist");
+        for(bin = 0; bin != REACTION_BINS; bin++)
+        {
+            EUSART_report_u32(stats->histogram[bin]);
+        }
+        EUSART_report("\r\n");
+    }
+    EUSART_enable(false);       // Return RB7 to SW5 for the next round
+    LED1 = 1;
+}
+
+// Run the reaction-time game. This function does not return.
+void REACTION_mode(void)
+{
+    uint32_t times[REACTION_PLAYERS];
+    uint32_t start;
+    uint32_t cueTime;
+    uint32_t best;
+    unsigned char valid;
+    unsigned char winners;
+    unsigned char p;
+    unsigned char i;
+
+    TIMEBASE_config();
+    EUSART_config(BAUD_115200);
+    EUSART_enable(false);
+    LED1 = 1;                   // D1 is only lit while reports are sent
+    for(p = 0; p != REACTION_PLAYERS; p++)
+    {
+        reactionStats[p].best = 0;
+        reactionStats[p].sum = 0;
+        reactionStats[p].count = 0;
+        reactionStats[p].falseStarts = 0;
+        for(i = 0; i != REACTION_BINS; i++)
+        {
+            reactionStats[p].histogram[i] = 0;
+        }
+    }
+
+    // Wait for the start-up button to be released, and use its timing to seed
+    // the random delay generator. Let the release bounce settle before
+    // enabling interrupt-on-change, so it can't become a false start.
+    while((PORTB & 0b11110000) != 0b11110000)
+        ;
+    reaction_wait(TIMEBASE_ticks(), TIMEBASE_DEBOUNCE_TICKS);
+    reactionRandom ^= (unsigned int)TIMEBASE_ticks();
+    if(reactionRandom == 0)
+    {
+        reactionRandom = 0xACE1;
+    }
+
+    // Interrupt-on-change for falling edges (presses) of SW2-SW5
+    reactionActive = true;
+    IOCBP = 0b00000000;
+    IOCBN = 0b11110000;
+
+    while(1)
+    {
+        // Start a round, recording any presses before the cue as false starts.
+        reaction_leds(0);
+        reactionRound++;
+        INTCONbits.IOCIE = 0;
+        IOCBF = 0;
+        reactionPressed = 0;
+        INTCONbits.IOCIE = 1;
+        start = TIMEBASE_ticks();
+        reaction_wait(start, (uint32_t)(REACTION_MIN_DELAY_MS +
+                (reaction_random() & REACTION_RANDOM_MS)) * TIMEBASE_TICKS_PER_MS);
+
+        // Cue: light all player LEDs, then take the cue timestamp.
+        reaction_leds(0b1111);
+        cueTime = TIMEBASE_ticks();
+        if(REACTION_BEEP)
+        {
+            for(i = 0; i != 100; i++)   // 25 ms, 2 kHz beep
+            {
+                BEEPER = !BEEPER;
+                __delay_us(250);
+            }
+        }
+
+        // Wait for all players, or the time-out.
+        while(reactionPressed != 0b1111 &&
+                TIMEBASE_ticks() - cueTime < (uint32_t)REACTION_TIMEOUT_MS * TIMEBASE_TICKS_PER_MS)
+        {
+            if(SW1 == 0)
+            {
+                RESET();
+            }
+        }
+        INTCONbits.IOCIE = 0;   // Freeze the round's press times
+        reaction_leds(0);
+
+        // Calculate reaction times. Presses before the cue are false starts.
+        valid = 0;
+        winners = 0;
+        best = 0;
+        for(p = 0; p != REACTION_PLAYERS; p++)
+        {
+            if(reactionPressed & (1 << p))
+            {
+                if((int32_t)(reactionPressTime[p] - cueTime) < 0)
+                {
+                    if(reactionStats[p].falseStarts != 255)
+                    {
+                        reactionStats[p].falseStarts++;
+                    }
+                }
+                else
+                {
+                    times[p] = TIMEBASE_us(reactionPressTime[p] - cueTime);
+                    reaction_record(&reactionStats[p], times[p]);
+                    if(valid == 0 || times[p] < best)
+                    {
+                        best = times[p];
+                        winners = 0;
+                    }
+                    if(times[p] == best)
+                    {
+                        winners |= (1 << p);    // Equal times share the win
+                    }
+                    valid |= (1 << p);
+                }
+            }
+        }
+
+        // Flash the winners' LEDs, then report.
+        for(i = 0; i != 3; i++)
+        {
+            reaction_leds(winners);
+            __delay_ms(150);
+            reaction_leds(0);
+            __delay_ms(150);
+        }
+        reaction_report(times, valid, winners);
+    }
+}
+
+// Return the statistics of a player.
+const REACTION_STATS *REACTION_stats(unsigned char player)
+{
+    return (&reactionStats[player]);
+}
+
+// Return the mean reaction time of a player in microseconds.
+uint32_t REACTION_mean_us(unsigned char player)
+{
+    if(reactionStats[player].count == 0)
+    {
+        return (0);
+    }
+    return (reactionStats[player].sum / reactionStats[player].count);
+}
+
+// Pushbutton interrupt handler (call from the ISR). All pending pushbutton
+// flags are read before the timestamp is taken, and every flagged player gets
+// the same timestamp.
+void REACTION_isr(void)
+{
+    unsigned char flags;
+    unsigned char players;
+    unsigned char p;
+    uint32_t now;
+
+    if(reactionActive && INTCONbits.IOCIE && INTCONbits.IOCIF)
+    {
+        flags = IOCBF & 0b11110000;
+        now = TIMEBASE_ticks();
+        IOCBF = IOCBF & ~flags;
+        players = (flags >> 4) & ~reactionPressed & 0b1111;
+        for(p = 0; p != REACTION_PLAYERS; p++)
+        {
+            if(players & (1 << p))
+            {
+                reactionPressTime[p] = now;
+            }
+        }
+        reactionPressed |= players;
+    }
+}
@@ -0,0 +1,85 @@
+/*==============================================================================
+ File: REACTION.h
+ Date: October 18, 2026
+
+ UBMP4.1 (PIC16F1459) multi-player reaction-time game constant definitions and
+ function prototypes
+
+ Operation:
+ Up to four players use pushbuttons SW2-SW5. After a random delay, LEDs D3-D6
+ light (and the beeper sounds) as the cue, and each player's first press is
+ timestamped by the interrupt-on-change interrupt using TIMEBASE.c, giving
+ reaction times with 0.667 us resolution. Presses before the cue are counted
+ as false starts. The fastest player's LED flashes at the end of each round.
+
+ Fairness:
+ All four pushbuttons share one interrupt-on-change interrupt. The interrupt
+ handler reads all of the pending pushbutton flags first, and then gives every
+ flagged player the same timestamp, so simultaneous presses produce equal times
+ and no player is favoured by the order in which pushbuttons are checked.
+
+ Statistics:
+ Each player's best time, mean time (from a 32-bit microsecond sum) and a
+ histogram of reaction times are kept. Histogram bins are 32.768 ms (2^15 us)
+ wide, so a bin number is calculated with a shift instead of a division - bin 0
+ is 0-32 ms, bin 5 is 164-196 ms, and the last bin also counts all slower times.
+
+ Reports:
+ Results and statistics are sent to the serial port (EUSART.c, 115200 baud)
+ after each round. The EUSART TX pin is shared with SW5, so the serial port is
+ only enabled while the report is sent, and LED D1 is lit during that time.
+ Player 4 should not press SW5 while D1 is lit.
+==============================================================================*/
+
+// Reaction game settings
+#define REACTION_PLAYERS        4       // Players (pushbuttons SW2-SW5)
+#define REACTION_MIN_DELAY_MS   1000    // Shortest random delay before the cue
+#define REACTION_RANDOM_MS      2047    // Random delay range (power of 2 - 1)
+#define REACTION_TIMEOUT_MS     1500    // Round ends this long after the cue
+#define REACTION_BEEP           true    // Sound the beeper with the LED cue
+#define REACTION_BINS           16      // Histogram bins per player
+#define REACTION_BIN_SHIFT      15      // Histogram bin width (2^15 us)
+
+// Per-player reaction time statistics
+typedef struct
+{
+    uint32_t best;                      // Best reaction time (us)
+    uint32_t sum;                       // Sum of reaction times (us)
+    unsigned char count;                // Valid reaction times
+    unsigned char falseStarts;          // Presses before the cue
+    unsigned char histogram[REACTION_BINS]; // Reaction time distribution
+} REACTION_STATS;
+
+// Prototypes for REACTION.c functions:
+
+/**
+ * Function: void REACTION_mode(void)
+ *
+ * Run the reaction-time game. Pressing SW1 resets UBMP4 into the bootloader.
+ * This function does not return.
+ */
+void REACTION_mode(void);
+
+/**
+ * Function: const REACTION_STATS *REACTION_stats(unsigned char player)
+ *
+ * Return the statistics of a player (0 - 3, for SW2 - SW5).
+ *
+ * Example usage: best = REACTION_stats(0)->best;
+ */
+const REACTION_STATS *REACTION_stats(unsigned char);
+
+/**
+ * Function: uint32_t REACTION_mean_us(unsigned char player)
+ *
+ * Return the mean reaction time of a player in microseconds (0 if none).
+ */
+uint32_t REACTION_mean_us(unsigned char);
+
+/**
+ * Function: void REACTION_isr(void)
+ *
+ * Pushbutton interrupt handler. Call this function from the main program's
+ * interrupt service routine.
+ */
+void REACTION_isr(void);
@@ -0,0 +1,290 @@
+/*==============================================================================
+ File: SYNCBUS.c
+ Date: October 18, 2026
+
+ UBMP4.1 (PIC16F1459) multi-board sync bus using H1 (data) and H2 (clock)
+
+ The bus position, slot and message state machine is in SYNCMSG.c, so that the
+ Linux simulation runs the same code. This file connects it to the pins, the
+ timebase and the interrupts. The master's Timer2 interrupt handler samples
+ the data bit sent by a node after the last clock edge, sets the data bit of
+ its own header slot, and then makes the next clock edge. The nodes' clock
+ edge (INT) interrupt handler sets the data bit of its own slot, times the
+ edge, and reads the header bit. Both handlers set the data bit first, from a
+ value prepared in the last bit clock period. Tick timestamps are filtered and
+ messages are prepared and checked by SYNCBUS_poll() in the main loop, since
+ the calculations take longer than one bit clock period. Include SYNCBUS.h in your main program to call these
+ functions.
+==============================================================================*/
+
+#include    "xc.h"              // XC compiler general include file
+
+#include    "stdint.h"          // Include integer definitions
+#include    "stdbool.h"         // Include Boolean (true/false) definitions
+
+#include    "UBMP410.h"         // Include UBMP4.1 constant and function definitions
+#include    "TIMEBASE.h"        // Include timebase constant and function definitions
+#include    "EUSART.h"          // Include EUSART constant and function definitions
+#include    "SYNCBUS.h"         // Include sync bus constant and function definitions
+#include    "SYNCMSG.h"         // Include sync bus state machine definitions
+
+bool syncbusActive = false;         // Sync bus owns the pushbutton interrupts
+unsigned char syncButtons = 0;      // Pushbutton pins used (PORTB bits)
+uint32_t syncPinTime[4];            // Last pushbutton change times (debounce)
+
+SYNCMSG_BUS syncBus;                // Bus state of this board
+
+// Configure the bus pins and interrupts and join the bus.
+void SYNCBUS_config(unsigned char node)
+{
+    ANSELCbits.ANSC0 = 0;       // Digital H1 and H2
+    ANSELCbits.ANSC1 = 0;
+    LATCbits.LATC0 = 0;         // Data line is pulled low by its TRIS bit
+    SYNCBUS_DATA_TRIS = 1;      // Release the data line
+    SYNCMSG_init(&syncBus, node, TIMEBASE_ticks());
+#ifdef SYNCBUS_TIMING_PIN
+    ANSELCbits.ANSC2 = 0;       // Digital H3 output for handler timing
+    SYNCBUS_TIMING_PIN = 0;
+    TRISCbits.TRISC2 = 0;
+#endif
+
+    // Pushbutton interrupt-on-change for both edges, for debouncing. SW5 (RB7)
+    // is the master's serial TX pin.
+    syncButtons = (node == 0) ? 0b01110000 : 0b11110000;
+    IOCBP = syncButtons;
+    IOCBN = syncButtons;
+    IOCBF = 0;
+    syncbusActive = true;
+    INTCONbits.IOCIE = 1;
+
+    if(node == 0)
+    {
+        // Master: Timer2 bit clock, 12 MHz / 4 prescaler / (SYNCBUS_PR2 + 1)
+        SYNCBUS_CLK = 1;
+        SYNCBUS_CLK_TRIS = 0;
+        PR2 = SYNCBUS_PR2;
+        TMR2 = 0;
+        T2CON = 0b00000101;     // 1:1 postscaler, Timer2 on, 1:4 prescaler
+        TMR2IF = 0;
+        TMR2IE = 1;
+        PEIE = 1;               // Enable peripheral interrupts
+    }
+    else
+    {
+        // Node: falling clock edge interrupt on INT (RC1)
+        SYNCBUS_CLK_TRIS = 1;
+        OPTION_REGbits.INTEDG = 0;
+        INTCONbits.INTF = 0;
+        INTCONbits.INTE = 1;
+    }
+    GIE = 1;                    // Enable global interrupts
+}
+
+// Prepare the next message, and check received master headers.
+void SYNCBUS_poll(void)
+{
+    SYNCMSG_poll(&syncBus);
+}
+
+// Return true if this board's clock is synchronized to the master.
+bool SYNCBUS_synced(void)
+{
+    return (SYNCMSG_synced(&syncBus, TIMEBASE_ticks()));
+}
+
+// Return the current common time in microseconds.
+uint32_t SYNCBUS_time_us(void)
+{
+    return (SYNCMSG_time_us(&syncBus, TIMEBASE_ticks()));
+}
+
+// Get the next press event collected by the master.
+bool SYNCBUS_event(SYNCBUS_EVENT *event)
+{
+    return (SYNCMSG_event(&syncBus, event));
+}
+
+// Select the node number and run the sync bus. This function does not return.
+void SYNCBUS_mode(void)
+{
+    SYNCBUS_EVENT event;
+    unsigned char node = 0;
+    bool SW3Pressed = false;
+    uint32_t reportTime;
+    uint32_t maxLatency = 0;
+    unsigned int events = 0;
+    unsigned int slots;
+
+    // Wait for the start-up button (SW5) to be released, then select the node
+    // number (shown in binary on LEDs D3-D5) with SW3 and start with SW2.
+    while(SW5 == 0)
+        ;
+    while(SW2 == 1)
+    {
+        LED3 = (node & 0b001) ? 1 : 0;
+        LED4 = (node & 0b010) ? 1 : 0;
+        LED5 = (node & 0b100) ? 1 : 0;
+        if(SW3 == 0 && !SW3Pressed)
+        {
+            node = (node + 1) & (SYNCBUS_NODES - 1);
+        }
+        SW3Pressed = (SW3 == 0);
+        __delay_ms(20);
+        if(SW1 == 0)
+        {
+            RESET();
+        }
+    }
+    while(SW2 == 0)
+        ;
+    __delay_ms(20);
+
+    TIMEBASE_config();
+    if(node == 0)
+    {
+        EUSART_config(BAUD_115200);
+    }
+    SYNCBUS_config(node);
+    reportTime = TIMEBASE_ticks();
+
+    while(1)
+    {
+        SYNCBUS_poll();
+        LED6 = SYNCBUS_synced();
+
+        // Master: report each press event, and the bus statistics every second.
+        if(node == 0)
+        {
+            if(SYNCBUS_event(&event))
+            {
+                events++;
+                if(event.latency > maxLatency)
+                {
+                    maxLatency = event.latency;
+                }
+                EUSART_report("node");
+                EUSART_report_u32(event.node);
+                EUSART_report(" buttons");
+                EUSART_report_u32(event.buttons);
+                EUSART_report(" time");
+                EUSART_report_u32(event.time);
+                EUSART_report(" latency");
+                EUSART_report_u32(event.latency);
+                EUSART_report("\r\n");
+            }
+            if(TIMEBASE_ticks() - reportTime >= 1000UL * TIMEBASE_TICKS_PER_MS)
+            {
+                reportTime += 1000UL * TIMEBASE_TICKS_PER_MS;
+                GIE = 0;
+                slots = syncBus.slotsUsed;
+                syncBus.slotsUsed = 0;
+                GIE = 1;
+                EUSART_report("events");
+                EUSART_report_u32(events);
+                EUSART_report(" errors");
+                EUSART_report_u32(syncBus.errors);
+                EUSART_report(" dropped");
+                EUSART_report_u32(syncBus.dropped);
+                EUSART_report(" max latency");
+                EUSART_report_u32(maxLatency);
+                // Bus use: slot bits / (bit clock periods per second / 100)
+                EUSART_report(" bus");
+                EUSART_report_u32((uint32_t)slots * SYNCBUS_SLOT_BITS /
+                        (SYNCBUS_PERIOD_BITS * 10000UL / SYNCBUS_TICK_US));
+                EUSART_report("%\r\n");
+                events = 0;
+            }
+        }
+
+        // Activate bootloader if SW1 is pressed.
+        if(SW1 == 0)
+        {
+            RESET();
+        }
+    }
+}
+
+// Bus clock, clock edge and pushbutton interrupt handler (call from the ISR).
+void SYNCBUS_isr(void)
+{
+    unsigned char flags;
+    unsigned char pin;
+    unsigned char i;
+    uint32_t now;
+    bool level;
+
+    if(!syncbusActive)
+    {
+        return;
+    }
+
+    // Node: falling clock edge. Only the tick is timestamped in full.
+    if(INTCONbits.INTE && INTCONbits.INTF)
+    {
+#ifdef SYNCBUS_TIMING_PIN
+        SYNCBUS_TIMING_PIN = 1;
+#endif
+        SYNCBUS_DATA_TRIS = syncBus.dataOut;
+        INTCONbits.INTF = 0;
+        if(SYNCMSG_node_edge(&syncBus, TIMEBASE_COARSE))
+        {
+            SYNCMSG_node_tick(&syncBus, TIMEBASE_ticks());
+        }
+        SYNCMSG_node_bit(&syncBus, SYNCBUS_DATA_IN);
+#ifdef SYNCBUS_TIMING_PIN
+        SYNCBUS_TIMING_PIN = 0;
+#endif
+    }
+
+    // Master: bit clock. The node bit is sampled at the end of its bit clock
+    // period, and header bits are set before the clock edge.
+    if(syncBus.node == 0 && TMR2IE && TMR2IF)
+    {
+#ifdef SYNCBUS_TIMING_PIN
+        SYNCBUS_TIMING_PIN = 1;
+#endif
+        TMR2IF = 0;
+        level = SYNCBUS_DATA_IN;
+        SYNCBUS_DATA_TRIS = syncBus.dataOut;
+        if(syncBus.bit == SYNCBUS_PERIOD_BITS - 1)
+        {
+            SYNCBUS_CLK = 0;    // Tick clock edge
+            SYNCMSG_master_tick(&syncBus, TIMEBASE_ticks());
+            SYNCBUS_CLK = 1;
+        }
+        else if(syncBus.bit < SYNCBUS_BURST_BITS - 1)
+        {
+            SYNCBUS_CLK = 0;    // Clock edge
+            SYNCBUS_CLK = 1;
+        }
+        SYNCMSG_master_bit(&syncBus, level);
+#ifdef SYNCBUS_TIMING_PIN
+        SYNCBUS_TIMING_PIN = 0;
+#endif
+    }
+
+    // Pushbutton changes. A press counts if the pushbutton hasn't changed for
+    // the debounce time, so contact bounce after presses and releases is ignored.
+    if(INTCONbits.IOCIE && INTCONbits.IOCIF)
+    {
+        flags = IOCBF & syncButtons;
+        now = TIMEBASE_ticks();
+        IOCBF = IOCBF & ~flags;
+        pin = 0;
+        for(i = 0; i != 4; i++)
+        {
+            if(flags & (0b00010000 << i))
+            {
+                if((PORTB & (0b00010000 << i)) == 0 && now - syncPinTime[i] >= TIMEBASE_DEBOUNCE_TICKS)
+                {
+                    pin |= (1 << i);
+                }
+                syncPinTime[i] = now;
+            }
+        }
+        if(pin != 0)
+        {
+            SYNCMSG_press(&syncBus, pin, now);
+        }
+    }
+}
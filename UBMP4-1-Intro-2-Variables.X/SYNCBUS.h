@@ -0,0 +1,173 @@
+/*==============================================================================
+ File: SYNCBUS.h
+ Date: October 18, 2026
+
+ UBMP4.1 (PIC16F1459) multi-board sync bus constant definitions and function
+ prototypes
+
+ Wiring:
+ Connect H1 (RC0, data) of every board together, H2 (RC1, clock) of every
+ board together, and the ground pins of every board together. Fit one pull-up
+ resistor (2.2k - 4.7k to +5V) on the data line and one (10k) on the clock
+ line. Boards are nodes 0-7 on the bus, and node 0 is the master.
+
+ Operation:
+ The master drives a bit clock on the clock line using Timer2. Every tick
+ period (10 ms) starts with a burst of SYNCBUS_BURST_BITS falling clock edges
+ and ends with an idle gap. The nodes' external interrupt (INT, on RC1)
+ timestamps every clock edge using TIMEBASE.c, and the first edge after a gap
+ is the tick. Each node measures its own timebase ticks per tick period, so
+ timestamps can be converted to the master's (common) time without the boards'
+ oscillators having to match - the bit clock is supplied by the master, so
+ oscillator differences don't affect the data bits either.
+
+ The data line is open-drain (wired-AND): a board drives it low for a 0 bit
+ and releases it for a 1 bit. Each tick period is divided into time slots
+ after the tick:
+   Slot 0           Master header (the number of the tick period)
+   Slot 1 - 7       Press event message from node 1 - 7, if it has one
+ Every slot is a start bit (0 if a message follows), a message, and a guard
+ bit. Messages (SYNCMSG.c) are 5 bytes - the node number and pushbuttons, a
+ 24-bit value, and a CRC-8. Node press events carry their age in common
+ microseconds at the tick of the slot they are sent in, so the master can
+ calculate each press's common time without sending its time to the nodes.
+
+ Bus timing:
+ The default 25 us bit clock sends a 42-bit slot in 1.05 ms, so all 8 slots
+ fit in 8.45 ms of each 10 ms period, and each node can send up to 100 events
+ per second. Event latency is up to one tick period plus the node's slot time,
+ and sync error depends on the interrupt latency variation of the boards. Use
+ the Linux simulation (sim/syncbus_sim.c), which runs the same bus state
+ machine (SYNCMSG.c), to measure bus utilization, sync error and worst-case
+ event latency for different settings.
+
+ Each board sets its data bit at the start of its interrupt handler, from a
+ value prepared in the last bit clock period, so the bit doesn't wait for the
+ slot bookkeeping. The node clock edge handler must still finish within one
+ bit clock period, or the next edge is handled late. Use SYNCBUS_TIMING_PIN
+ to measure the handlers of the built image, set the simulation's interrupt
+ timing to the measured times, and lengthen SYNCBUS_BIT_US if the simulation
+ shows errors.
+==============================================================================*/
+
+// Sync bus pins
+#define SYNCBUS_DATA_IN     PORTCbits.RC0   // H1 data line input
+#define SYNCBUS_DATA_TRIS   TRISCbits.TRISC0    // H1 data output (0 = drive low)
+#define SYNCBUS_CLK         LATCbits.LATC1  // H2 clock line output (master)
+#define SYNCBUS_CLK_TRIS    TRISCbits.TRISC1    // H2 clock direction
+
+// Sync bus timing settings (all boards on a bus must use the same settings)
+#define SYNCBUS_BIT_US      25      // Bit clock period (us, up to 85)
+#define SYNCBUS_PR2         (SYNCBUS_BIT_US * 3 - 1)    // 3 MHz / (PR2 + 1)
+#define SYNCBUS_PERIOD_BITS 400     // Bit clock periods per tick period
+#define SYNCBUS_TICK_US     (SYNCBUS_BIT_US * SYNCBUS_PERIOD_BITS)  // 10 ms
+#define SYNCBUS_TICK_TICKS  (SYNCBUS_TICK_US * 3 / 2)   // Timebase ticks per tick
+#define SYNCBUS_GAP_TICKS   512     // Clock gap before a tick (341 us or more)
+#define SYNCBUS_EDGE_TICKS  9       // Node clock edge to tick timestamp (ticks)
+#define SYNCBUS_LATE_TICKS  3       // Largest normal latency variation (ticks)
+#define SYNCBUS_BLOCK_TICKS 30      // Longest delay by other interrupts (ticks)
+
+// Sync bus slots
+#define SYNCBUS_NODES       8       // Nodes, including the master (node 0)
+#define SYNCBUS_MSG_BYTES   5       // Message length (bytes)
+#define SYNCBUS_SLOT_START  2       // First bit of the master header slot
+#define SYNCBUS_SLOT_BITS   (SYNCBUS_MSG_BYTES * 8 + 2) // Start, message, guard
+#define SYNCBUS_BURST_BITS  (SYNCBUS_SLOT_START + SYNCBUS_NODES * SYNCBUS_SLOT_BITS)
+#define SYNCBUS_MAX_AGE     0xFFFFFF    // Largest 24-bit message value
+#define SYNCBUS_TICK_MASK   0xFFFFFF    // Tick period numbers are 24 bits
+
+// Clock edges are timed in units of 256 timebase ticks (TIMEBASE_COARSE), so
+// bit clock periods must be shorter than that and tick gaps longer.
+#if SYNCBUS_PR2 > 255 || SYNCBUS_BIT_US * 3 / 2 + SYNCBUS_BLOCK_TICKS >= 256
+#error "SYNCBUS_BIT_US is too long"
+#endif
+#if (SYNCBUS_PERIOD_BITS - SYNCBUS_BURST_BITS) * SYNCBUS_BIT_US * 3 / 2 < SYNCBUS_GAP_TICKS + 256
+#error "SYNCBUS_PERIOD_BITS is too short for the slots and the tick gap"
+#endif
+
+// Uncomment to make H3 high while the sync bus interrupt handler runs, to
+// measure its timing on an oscilloscope along with H1 and H2.
+// #define SYNCBUS_TIMING_PIN  H3OUT
+
+// Sync bus queue sizes (powers of 2)
+#define SYNCBUS_QUEUE_SIZE  4       // Press events waiting to be sent
+#define SYNCBUS_RX_SIZE     8       // Messages received by the master
+
+// Press event, in common time
+typedef struct
+{
+    unsigned char node;             // Node number (0 = master)
+    unsigned char buttons;          // Pressed buttons (bit 0 = SW2 - bit 3 = SW5)
+    uint32_t time;                  // Common time of the press (us)
+    uint32_t latency;               // Press to reception by the master (us)
+} SYNCBUS_EVENT;
+
+// Prototypes for SYNCBUS.c functions:
+
+/**
+ * Function: void SYNCBUS_config(unsigned char node)
+ *
+ * Configure the bus pins and interrupts and join the bus as the specified
+ * node (0 is the master). Pushbutton presses (SW2-SW5, or SW2-SW4 on the
+ * master, where SW5 is the serial TX pin) become press events. Requires
+ * TIMEBASE_config().
+ *
+ * Example usage: SYNCBUS_config(3);
+ */
+void SYNCBUS_config(unsigned char);
+
+/**
+ * Function: void SYNCBUS_poll(void)
+ *
+ * Prepare the next message to send on the bus, and check received master
+ * headers. Call this function from the main loop at least once every tick
+ * period.
+ */
+void SYNCBUS_poll(void);
+
+/**
+ * Function: bool SYNCBUS_synced(void)
+ *
+ * Return true if this board's clock is synchronized to the master. The master
+ * is always synchronized.
+ */
+bool SYNCBUS_synced(void);
+
+/**
+ * Function: uint32_t SYNCBUS_time_us(void)
+ *
+ * Return the current common time in microseconds, which is the same on every
+ * synchronized board.
+ *
+ * Example usage: now = SYNCBUS_time_us();
+ */
+uint32_t SYNCBUS_time_us(void);
+
+/**
+ * Function: bool SYNCBUS_event(SYNCBUS_EVENT *event)
+ *
+ * Master only: get the next press event collected from the bus (or from the
+ * master's own pushbuttons). Returns false if there are no events.
+ *
+ * Example usage: if(SYNCBUS_event(&event)) ...
+ */
+bool SYNCBUS_event(SYNCBUS_EVENT *);
+
+/**
+ * Function: void SYNCBUS_mode(void)
+ *
+ * Select the node number and run the sync bus. LEDs D3-D5 show the node
+ * number in binary, SW3 changes it, and SW2 starts. The master reports every
+ * press event and the bus statistics on the serial port (EUSART.c, 115200
+ * baud). SW1 resets UBMP4 into the bootloader. This function does not return.
+ */
+void SYNCBUS_mode(void);
+
+/**
+ * Function: void SYNCBUS_isr(void)
+ *
+ * Bus clock, clock edge and pushbutton interrupt handler. Call this function
+ * first in the main program's interrupt service routine to keep the clock
+ * edge timestamp latency short.
+ */
+void SYNCBUS_isr(void);
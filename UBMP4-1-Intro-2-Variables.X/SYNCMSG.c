@@ -0,0 +1,520 @@
+/*==============================================================================
+ File: SYNCMSG.c
+ Date: October 18, 2026
+
+ Sync bus state machine, message packing and common time conversion
+
+ This file does not use any PIC hardware (other than the global interrupt
+ enable bit, when it is compiled by XC8), so that it can also be compiled into
+ the Linux sync bus simulation (sim/syncbus_sim.c). SYNCBUS.c reads the pins
+ and timebase and passes them to the interrupt handler functions here. Include
+ SYNCMSG.h in your program to call these functions.
+==============================================================================*/
+
+#ifdef __XC8
+#include    "xc.h"              // XC compiler general include file
+#endif
+
+#include    "stdint.h"          // Include integer definitions
+#include    "stdbool.h"         // Include Boolean (true/false) definitions
+
+#include    "CRC8.h"            // Include CRC-8 function definitions
+#include    "SYNCBUS.h"         // Include sync bus constant definitions
+#include    "SYNCMSG.h"         // Include sync bus state machine definitions
+
+// Main loop functions hold off the interrupt handler while they read or change
+// state shared with it. The simulation runs handlers between main loop calls.
+#ifdef __XC8
+#define LOCK()          GIE = 0
+#define UNLOCK()        GIE = 1
+#else
+#define LOCK()
+#define UNLOCK()
+#endif
+
+// Queue index masks (queue sizes are powers of 2)
+#define PRESS_MASK      (SYNCBUS_QUEUE_SIZE - 1)
+#define RX_MASK         (SYNCBUS_RX_SIZE - 1)
+
+#define NO_SLOT         0xFF        // Not in a slot (tick or idle gap)
+
+// Fill a message buffer.
+void SYNCMSG_pack(unsigned char *msg, unsigned char node, unsigned char buttons, uint32_t value)
+{
+    if(value > SYNCBUS_MAX_AGE)
+    {
+        value = SYNCBUS_MAX_AGE;
+    }
+    msg[0] = (unsigned char)((node << 4) | (buttons & 0x0F));
+    msg[1] = (unsigned char)(value >> 16);
+    msg[2] = (unsigned char)(value >> 8);
+    msg[3] = (unsigned char)value;
+    msg[4] = CRC8_calc(msg, SYNCBUS_MSG_BYTES - 1);
+}
+
+// Check a received message and return its fields if its CRC is good.
+bool SYNCMSG_unpack(const unsigned char *msg, unsigned char *node, unsigned char *buttons, uint32_t *value)
+{
+    if(CRC8_calc(msg, SYNCBUS_MSG_BYTES - 1) != msg[4])
+    {
+        return (false);
+    }
+    *node = msg[0] >> 4;
+    *buttons = msg[0] & 0x0F;
+    *value = ((uint32_t)msg[1] << 16) | ((uint32_t)msg[2] << 8) | msg[3];
+    return (true);
+}
+
+// Average the measured timebase ticks per tick period.
+unsigned int SYNCMSG_period(uint32_t *filter, uint32_t ticks)
+{
+    if(ticks > SYNCBUS_TICK_TICKS - SYNCBUS_TICK_TICKS / 16 &&
+            ticks < SYNCBUS_TICK_TICKS + SYNCBUS_TICK_TICKS / 16)
+    {
+        if(*filter == 0)
+        {
+            *filter = ticks << 4;   // First measurement
+        }
+        else
+        {
+            *filter += ticks - (*filter >> 4);
+        }
+    }
+    if(*filter == 0)
+    {
+        return (SYNCBUS_TICK_TICKS);
+    }
+    return ((unsigned int)((*filter + 8) >> 4));
+}
+
+// Return the timestamp of a tick. Clock edge interrupts can be delayed (but
+// never early), so an edge timestamp that is later than predicted from the last
+// tick and the averaged period is replaced by the prediction.
+uint32_t SYNCMSG_tick_time(uint32_t edge, uint32_t last, uint32_t filter)
+{
+    uint32_t predicted;
+    int32_t late;
+
+    if(filter == 0)
+    {
+        return (edge);          // No period measurements yet
+    }
+    predicted = last + ((filter + 8) >> 4);
+    late = (int32_t)(edge - predicted);
+    if(late > SYNCBUS_LATE_TICKS && late <= SYNCBUS_BLOCK_TICKS)
+    {
+        return (predicted);
+    }
+    return (edge);
+}
+
+// Convert timebase ticks to common microseconds. Whole tick periods and the
+// remainder are converted separately to avoid overflowing 32 bits.
+uint32_t SYNCMSG_scale_us(uint32_t ticks, unsigned int period)
+{
+    uint32_t periods;
+    uint32_t remainder;
+
+    periods = ticks / period;
+    if(periods > SYNCBUS_MAX_AGE / SYNCBUS_TICK_US)
+    {
+        return (SYNCBUS_MAX_AGE + 1UL);
+    }
+    remainder = ticks - periods * period;
+    return (periods * SYNCBUS_TICK_US +
+            (remainder * SYNCBUS_TICK_US + period / 2) / period);
+}
+
+// Return an event's age at the tick after the last one.
+uint32_t SYNCMSG_age_us(int32_t ticks, unsigned int period)
+{
+    uint32_t us;
+
+    if(ticks >= 0)
+    {
+        return (SYNCBUS_TICK_US + SYNCMSG_scale_us((uint32_t)ticks, period));
+    }
+    us = SYNCMSG_scale_us((uint32_t)-ticks, period);
+    if(us > SYNCBUS_TICK_US)
+    {
+        return (0);             // Event was after the next tick
+    }
+    return (SYNCBUS_TICK_US - us);
+}
+
+// Clear the bus state and join the bus.
+void SYNCMSG_init(SYNCMSG_BUS *bus, unsigned char node, uint32_t now)
+{
+    unsigned char *clear = (unsigned char *)bus;
+    unsigned int i;
+
+    for(i = 0; i != sizeof(SYNCMSG_BUS); i++)
+    {
+        clear[i] = 0;
+    }
+    bus->node = node;
+    bus->slot = NO_SLOT;
+    bus->slotStart = SYNCBUS_SLOT_START + node * SYNCBUS_SLOT_BITS;
+    bus->dataOut = true;
+    bus->tickEdge = now;
+    bus->tickTime = now;
+    bus->period = SYNCBUS_TICK_TICKS;
+    if(node == 0)
+    {
+        bus->bit = SYNCBUS_PERIOD_BITS - 1; // First bit clock period is a tick
+    }
+}
+
+// Load a message into this board's slot for the tick period after ticks, if
+// the message isn't being sent and there hasn't been a tick since.
+static void msg_load(SYNCMSG_BUS *bus, const unsigned char *msg, uint32_t ticks)
+{
+    unsigned char i;
+
+    LOCK();
+    if(bus->ticks == ticks && !bus->msgArmed)
+    {
+        for(i = 0; i != SYNCBUS_MSG_BYTES; i++)
+        {
+            bus->msg[i] = msg[i];
+        }
+        bus->msgTick = (unsigned char)(ticks + 1);
+    }
+    UNLOCK();
+}
+
+// Handle the last tick, prepare the next message, and check received master
+// headers.
+void SYNCMSG_poll(SYNCMSG_BUS *bus)
+{
+    unsigned char msg[SYNCBUS_MSG_BYTES];
+    unsigned char node;
+    unsigned char buttons;
+    uint32_t value;
+    uint32_t ticks;
+    uint32_t tickEdge;
+
+    // Handle the last tick. Node tick timestamps are corrected for the clock
+    // edge interrupt latency, and averaged into the ticks per tick period.
+    LOCK();
+    ticks = bus->ticks;
+    tickEdge = bus->tickEdge;
+    UNLOCK();
+    if(ticks != bus->lastTick)
+    {
+        if(bus->node != 0)
+        {
+            tickEdge = SYNCMSG_tick_time(tickEdge - SYNCBUS_EDGE_TICKS, bus->tickTime, bus->periodFilter);
+            bus->period = SYNCMSG_period(&bus->periodFilter, tickEdge - bus->tickTime);
+        }
+        bus->tickTime = tickEdge;
+        bus->lastTick = ticks;
+    }
+
+    if(bus->node == 0)
+    {
+        // Master: header for the next tick period.
+        if(bus->msgTick != (unsigned char)(ticks + 1))
+        {
+            SYNCMSG_pack(msg, 0, 0, (ticks + 1) & SYNCBUS_TICK_MASK);
+            msg_load(bus, msg, ticks);
+        }
+        return;
+    }
+
+    // Node: the master header gives the tick period number.
+    if(bus->headerReady)
+    {
+        if(SYNCMSG_unpack(bus->header, &node, &buttons, &value) && node == 0)
+        {
+            LOCK();
+            bus->tickOffset = value - bus->headerTicks;
+            UNLOCK();
+            bus->locked = true;
+        }
+        bus->headerReady = false;
+    }
+
+    // Take the next press event, and calculate its age at the next tick once
+    // the tick period number and this board's ticks per tick period are known.
+    if(!bus->locked || bus->periodFilter == 0)
+    {
+        return;
+    }
+    if(!bus->msgPending && bus->pressHead != bus->pressTail)
+    {
+        bus->msgTime = bus->pressTime[bus->pressTail & PRESS_MASK];
+        bus->msgButtons = bus->pressButtons[bus->pressTail & PRESS_MASK];
+        bus->pressTail++;
+        bus->msgTick = (unsigned char)ticks;    // Not armed until loaded
+        bus->msgPending = true;
+    }
+    if(bus->msgPending && bus->msgTick != (unsigned char)(ticks + 1))
+    {
+        SYNCMSG_pack(msg, bus->node, bus->msgButtons,
+                SYNCMSG_age_us((int32_t)(bus->tickTime - bus->msgTime), bus->period));
+        msg_load(bus, msg, ticks);
+    }
+}
+
+// Return true if this board's clock is synchronized to the master.
+bool SYNCMSG_synced(SYNCMSG_BUS *bus, uint32_t now)
+{
+    if(bus->node == 0)
+    {
+        return (true);
+    }
+    return (bus->locked && (int32_t)(now - bus->tickTime) < (int32_t)(2UL * SYNCBUS_TICK_TICKS));
+}
+
+// Convert a timebase time to common microseconds, from the last tick handled
+// by SYNCMSG_poll(). The time can be before that tick.
+uint32_t SYNCMSG_time_us(SYNCMSG_BUS *bus, uint32_t now)
+{
+    uint32_t us;
+    int32_t ticksAfter;
+
+    us = ((bus->lastTick + bus->tickOffset) & SYNCBUS_TICK_MASK) * SYNCBUS_TICK_US;
+    ticksAfter = (int32_t)(now - bus->tickTime);
+    if(ticksAfter >= 0)
+    {
+        return (us + SYNCMSG_scale_us((uint32_t)ticksAfter, bus->period));
+    }
+    return (us - SYNCMSG_scale_us((uint32_t)-ticksAfter, bus->period));
+}
+
+// Get the next press event collected by the master.
+bool SYNCMSG_event(SYNCMSG_BUS *bus, SYNCBUS_EVENT *event)
+{
+    unsigned char entry;
+    unsigned char node;
+    unsigned char buttons;
+    uint32_t age;
+
+    // The master's own presses, timed from its last tick.
+    if(bus->pressHead != bus->pressTail)
+    {
+        entry = bus->pressTail & PRESS_MASK;
+        event->node = 0;
+        event->buttons = bus->pressButtons[entry];
+        event->time = SYNCMSG_time_us(bus, bus->pressTime[entry]);
+        event->latency = 0;
+        bus->pressTail++;
+        return (true);
+    }
+
+    // Node presses, timed from the tick of the period they were received in.
+    while(bus->rxHead != bus->rxTail)
+    {
+        entry = bus->rxTail & RX_MASK;
+        bus->rxTail++;
+        if(SYNCMSG_unpack(bus->rxQueue[entry], &node, &buttons, &age) && node == bus->rxNode[entry])
+        {
+            event->node = node;
+            event->buttons = buttons;
+            event->time = bus->rxTick[entry] * SYNCBUS_TICK_US - age;
+            event->latency = age + (uint32_t)(SYNCBUS_SLOT_START +
+                    (node + 1) * SYNCBUS_SLOT_BITS) * SYNCBUS_BIT_US;
+            return (true);
+        }
+        bus->errors++;
+    }
+    return (false);
+}
+
+// Queue a debounced press.
+void SYNCMSG_press(SYNCMSG_BUS *bus, unsigned char buttons, uint32_t now)
+{
+    if((unsigned char)(bus->pressHead - bus->pressTail) == SYNCBUS_QUEUE_SIZE)
+    {
+        bus->dropped++;
+        return;
+    }
+    bus->pressTime[bus->pressHead & PRESS_MASK] = now;
+    bus->pressButtons[bus->pressHead & PRESS_MASK] = buttons;
+    bus->pressHead++;
+}
+
+// Advance the bus position by one bit clock period.
+static void slot_advance(SYNCMSG_BUS *bus)
+{
+    bus->bit++;
+    if(bus->bit == SYNCBUS_SLOT_START)
+    {
+        bus->slot = 0;
+        bus->slotBit = 0;
+    }
+    else if(bus->slot != NO_SLOT)
+    {
+        if(++bus->slotBit == SYNCBUS_SLOT_BITS)
+        {
+            bus->slotBit = 0;
+            if(++bus->slot == SYNCBUS_NODES)
+            {
+                bus->slot = NO_SLOT;
+            }
+        }
+    }
+}
+
+// Prepare the data output for the bit clock period after the current one. In
+// this board's slot, that is a start bit (0 if a message follows), the message,
+// and a released guard bit.
+static void slot_send(SYNCMSG_BUS *bus)
+{
+    unsigned int sendBit;
+    bool level;
+
+    sendBit = bus->bit + 1 - bus->slotStart;    // Wraps if before the slot
+    if(sendBit >= SYNCBUS_SLOT_BITS)
+    {
+        level = true;
+    }
+    else if(sendBit == 0)
+    {
+        level = !bus->msgArmed;
+        bus->txIndex = 0;
+        bus->txMask = 0b10000000;
+    }
+    else if(sendBit == SYNCBUS_SLOT_BITS - 1 || !bus->msgArmed)
+    {
+        level = true;
+        if(sendBit == SYNCBUS_SLOT_BITS - 1 && bus->msgArmed)
+        {
+            bus->msgArmed = false;  // Message sent
+            bus->msgPending = false;
+            bus->slotsUsed++;
+        }
+    }
+    else
+    {
+        level = (bus->msg[bus->txIndex] & bus->txMask) != 0;
+        bus->txMask >>= 1;
+        if(bus->txMask == 0)
+        {
+            bus->txMask = 0b10000000;
+            bus->txIndex++;
+        }
+    }
+    bus->dataOut = level;
+}
+
+// Receive the current bit of another board's slot. Returns true at the guard
+// bit if a message was received in rxMsg.
+static bool slot_receive(SYNCMSG_BUS *bus, bool level)
+{
+    if(bus->slotBit == 0)
+    {
+        bus->rxPresent = !level;    // Start bit
+        bus->rxIndex = 0;
+        bus->rxBits = 0;
+        return (false);
+    }
+    if(!bus->rxPresent)
+    {
+        return (false);
+    }
+    if(bus->slotBit == SYNCBUS_SLOT_BITS - 1)
+    {
+        return (true);
+    }
+    bus->rxByte = (bus->rxByte << 1) | level;
+    if(++bus->rxBits == 8)
+    {
+        bus->rxMsg[bus->rxIndex++] = bus->rxByte;
+        bus->rxBits = 0;
+    }
+    return (false);
+}
+
+// Node: handle a falling clock edge. The first edge after a gap is the tick.
+// Edges are timed coarsely, so that only ticks need a full timestamp.
+bool SYNCMSG_node_edge(SYNCMSG_BUS *bus, unsigned char edge)
+{
+    unsigned char elapsed;
+
+    elapsed = edge - bus->lastEdge;
+    bus->lastEdge = edge;
+    if(elapsed >= SYNCBUS_GAP_TICKS / 256)
+    {
+        return (true);
+    }
+    slot_advance(bus);
+    return (false);
+}
+
+// Node: start a tick period. The timestamp is filtered by SYNCMSG_poll().
+void SYNCMSG_node_tick(SYNCMSG_BUS *bus, uint32_t now)
+{
+    bus->tickEdge = now;
+    bus->ticks++;
+    bus->bit = 0;
+    bus->slot = NO_SLOT;
+    bus->msgArmed = (bus->msgPending && bus->msgTick == (unsigned char)bus->ticks);
+}
+
+// Node: receive a master header bit, and prepare this node's next bit. The
+// master sets header bits before the clock edge, and nodes set their bits
+// after it.
+void SYNCMSG_node_bit(SYNCMSG_BUS *bus, bool level)
+{
+    unsigned char i;
+
+    if(bus->slot == 0 && slot_receive(bus, level))
+    {
+        for(i = 0; i != SYNCBUS_MSG_BYTES; i++)
+        {
+            bus->header[i] = bus->rxMsg[i];
+        }
+        bus->headerTicks = bus->ticks;
+        bus->headerReady = true;
+    }
+    slot_send(bus);
+}
+
+// Master: receive the bit a node set after the last clock edge, then move to
+// the new bit clock period and prepare the next header bit, if any.
+void SYNCMSG_master_bit(SYNCMSG_BUS *bus, bool level)
+{
+    unsigned char entry;
+    unsigned char i;
+
+    if(bus->slot != NO_SLOT && bus->slot != 0 && slot_receive(bus, level))
+    {
+        bus->slotsUsed++;
+        if((unsigned char)(bus->rxHead - bus->rxTail) == SYNCBUS_RX_SIZE)
+        {
+            bus->dropped++;
+        }
+        else
+        {
+            entry = bus->rxHead & RX_MASK;
+            for(i = 0; i != SYNCBUS_MSG_BYTES; i++)
+            {
+                bus->rxQueue[entry][i] = bus->rxMsg[i];
+            }
+            bus->rxNode[entry] = bus->slot;
+            bus->rxTick[entry] = bus->ticks;
+            bus->rxHead++;
+        }
+    }
+
+    if(bus->bit == SYNCBUS_PERIOD_BITS - 1)
+    {
+        bus->bit = 0;
+        bus->slot = NO_SLOT;
+    }
+    else
+    {
+        slot_advance(bus);
+    }
+    slot_send(bus);
+}
+
+// Master: start a tick period at the tick clock edge.
+void SYNCMSG_master_tick(SYNCMSG_BUS *bus, uint32_t now)
+{
+    bus->tickEdge = now;
+    bus->ticks = (bus->ticks + 1) & SYNCBUS_TICK_MASK;
+    bus->msgArmed = (bus->msgTick == (unsigned char)bus->ticks);
+}
@@ -0,0 +1,254 @@
+/*==============================================================================
+ File: SYNCMSG.h
+ Date: October 18, 2026
+
+ Sync bus state machine, message and common time function prototypes
+
+ These functions do not use any PIC hardware, so that the Linux sync bus
+ simulation (sim/syncbus_sim.c) runs the same code as UBMP4. The bus state of
+ a board is kept in a SYNCMSG_BUS structure. Interrupt handler functions are
+ given the data line level and prepare this board's data output for the next
+ bit clock period, and SYNCBUS.c reads and writes the pins. The interrupt
+ handler functions only do the work that can't wait for the next bit clock
+ period, and tick timestamps are filtered by SYNCMSG_poll(). Include SYNCBUS.h before this file for the bus
+ settings.
+
+ Message format (SYNCBUS_MSG_BYTES bytes, most significant bit first):
+   node << 4 | buttons      Node number and pushbuttons (0 in headers)
+   value (3 bytes)          Tick period number (headers) or event age (us)
+   CRC                      CRC-8 (CRC8.c) of the first 4 bytes
+==============================================================================*/
+
+// Sync bus state of one board. Fields marked volatile are written by the
+// interrupt handler functions and read by the main loop functions.
+typedef struct
+{
+    unsigned char node;                 // This board's node number (0 = master)
+
+    // Bus position
+    unsigned int bit;                   // Bit clock periods since the tick
+    unsigned char slot;                 // Current slot
+    unsigned char slotBit;              // Bit in the current slot
+    unsigned int slotStart;             // First bit of this board's slot
+    bool dataOut;                       // Data output for the next bit period
+    unsigned char lastEdge;             // Node: coarse time of the last edge
+
+    // Tick periods counted by the interrupt handler functions
+    volatile uint32_t ticks;            // Tick periods counted by this board
+    volatile uint32_t tickEdge;         // Timestamp of the last tick clock edge
+
+    // Common time: the last tick handled by SYNCMSG_poll() and the timebase
+    // ticks per period
+    uint32_t lastTick;                  // Tick period number of tickTime
+    uint32_t tickTime;                  // Timestamp of the last tick
+    unsigned int period;                // Averaged timebase ticks per period
+    uint32_t periodFilter;              // SYNCMSG_period() filter
+    uint32_t tickOffset;                // Node: master's tick number - ticks
+    bool locked;                        // Node: tickOffset has been received
+
+    // Message for this board's slot (master header or node press event)
+    unsigned char msg[SYNCBUS_MSG_BYTES];
+    volatile unsigned char msgTick;     // Tick period the message is for
+    volatile bool msgArmed;             // Message is being sent this period
+    volatile bool msgPending;           // Node: press event waiting to be sent
+    uint32_t msgTime;                   // Node: time of the press event
+    unsigned char msgButtons;
+    unsigned char txIndex;
+    unsigned char txMask;
+
+    // Slot receiver
+    unsigned char rxMsg[SYNCBUS_MSG_BYTES];
+    unsigned char rxIndex;
+    unsigned char rxBits;
+    unsigned char rxByte;
+    bool rxPresent;
+
+    // Node: received master header
+    unsigned char header[SYNCBUS_MSG_BYTES];
+    uint32_t headerTicks;               // ticks when the header was received
+    volatile bool headerReady;
+
+    // Press event queue. Head is advanced by SYNCMSG_press(), tail by the
+    // main loop functions.
+    uint32_t pressTime[SYNCBUS_QUEUE_SIZE];
+    unsigned char pressButtons[SYNCBUS_QUEUE_SIZE];
+    volatile unsigned char pressHead;
+    unsigned char pressTail;
+
+    // Master: received message queue
+    unsigned char rxQueue[SYNCBUS_RX_SIZE][SYNCBUS_MSG_BYTES];
+    unsigned char rxNode[SYNCBUS_RX_SIZE];
+    uint32_t rxTick[SYNCBUS_RX_SIZE];
+    volatile unsigned char rxHead;
+    unsigned char rxTail;
+
+    // Statistics
+    volatile unsigned int slotsUsed;    // Slots carrying messages
+    volatile unsigned char dropped;     // Queue overflows
+    unsigned int errors;                // Messages with a bad CRC or node number
+} SYNCMSG_BUS;
+
+// Prototypes for SYNCMSG.c functions:
+
+/**
+ * Function: void SYNCMSG_pack(unsigned char *msg, unsigned char node, unsigned char buttons, uint32_t value)
+ *
+ * Fill msg with a message. Values larger than SYNCBUS_MAX_AGE are limited to
+ * SYNCBUS_MAX_AGE.
+ *
+ * Example usage: SYNCMSG_pack(msg, 3, 0b0001, age);
+ */
+void SYNCMSG_pack(unsigned char *, unsigned char, unsigned char, uint32_t);
+
+/**
+ * Function: bool SYNCMSG_unpack(const unsigned char *msg, unsigned char *node, unsigned char *buttons, uint32_t *value)
+ *
+ * Check the CRC of a received message and return its fields. Returns false
+ * (and leaves the fields unchanged) if the CRC is wrong.
+ */
+bool SYNCMSG_unpack(const unsigned char *, unsigned char *, unsigned char *, uint32_t *);
+
+/**
+ * Function: unsigned int SYNCMSG_period(uint32_t *filter, uint32_t ticks)
+ *
+ * Average the measured timebase ticks between two ticks of the bus, ignoring
+ * measurements more than 1/16 from SYNCBUS_TICK_TICKS (eg. missed ticks), and
+ * return the averaged ticks per tick period. filter holds 16 times the average,
+ * and must start at 0.
+ */
+unsigned int SYNCMSG_period(uint32_t *, uint32_t);
+
+/**
+ * Function: uint32_t SYNCMSG_tick_time(uint32_t edge, uint32_t last, uint32_t filter)
+ *
+ * Return the timestamp of a tick from the timestamp of its clock edge, the
+ * last tick's timestamp, and the SYNCMSG_period() filter. Edges timestamped
+ * more than SYNCBUS_LATE_TICKS (and up to SYNCBUS_BLOCK_TICKS) later than
+ * predicted were delayed by other interrupts, and the predicted time is
+ * returned instead.
+ */
+uint32_t SYNCMSG_tick_time(uint32_t, uint32_t, uint32_t);
+
+/**
+ * Function: uint32_t SYNCMSG_scale_us(uint32_t ticks, unsigned int period)
+ *
+ * Convert a number of this board's timebase ticks to common microseconds using
+ * this board's ticks per tick period. Returns SYNCBUS_MAX_AGE + 1 if the
+ * result is larger than SYNCBUS_MAX_AGE.
+ */
+uint32_t SYNCMSG_scale_us(uint32_t, unsigned int);
+
+/**
+ * Function: uint32_t SYNCMSG_age_us(int32_t ticks, unsigned int period)
+ *
+ * Return the age of an event in common microseconds at the tick after the last
+ * one, from the number of timebase ticks between the event and the last tick
+ * (positive if the event was before the last tick) and the ticks per tick
+ * period.
+ *
+ * Example usage: age = SYNCMSG_age_us((int32_t)(tickTime - pressTime), period);
+ */
+uint32_t SYNCMSG_age_us(int32_t, unsigned int);
+
+/**
+ * Function: void SYNCMSG_init(SYNCMSG_BUS *bus, unsigned char node, uint32_t now)
+ *
+ * Clear the bus state and join the bus as the specified node (0 is the
+ * master) at timebase time now. The master's first bit clock period starts a
+ * tick.
+ */
+void SYNCMSG_init(SYNCMSG_BUS *, unsigned char, uint32_t);
+
+/**
+ * Function: void SYNCMSG_poll(SYNCMSG_BUS *bus)
+ *
+ * Main loop: handle the last tick, prepare the next message for this board's
+ * slot, and check received master headers. Must be called at least once every
+ * tick period.
+ */
+void SYNCMSG_poll(SYNCMSG_BUS *);
+
+/**
+ * Function: bool SYNCMSG_synced(SYNCMSG_BUS *bus, uint32_t now)
+ *
+ * Main loop: return true if this board has received the master's tick number
+ * and has seen a tick within the last two tick periods before timebase time
+ * now. The master is always synchronized.
+ */
+bool SYNCMSG_synced(SYNCMSG_BUS *, uint32_t);
+
+/**
+ * Function: uint32_t SYNCMSG_time_us(SYNCMSG_BUS *bus, uint32_t now)
+ *
+ * Main loop: convert timebase time now to common microseconds. now may be
+ * read just before a tick is handled.
+ */
+uint32_t SYNCMSG_time_us(SYNCMSG_BUS *, uint32_t);
+
+/**
+ * Function: bool SYNCMSG_event(SYNCMSG_BUS *bus, SYNCBUS_EVENT *event)
+ *
+ * Main loop, master only: get the next press event, either from the master's
+ * own press queue or from a message received from a node. Returns false if
+ * there are no events. Received messages with a bad CRC or node number are
+ * counted in bus->errors.
+ */
+bool SYNCMSG_event(SYNCMSG_BUS *, SYNCBUS_EVENT *);
+
+/**
+ * Function: void SYNCMSG_press(SYNCMSG_BUS *bus, unsigned char buttons, uint32_t now)
+ *
+ * Interrupt handler: queue a debounced press of buttons at timebase time now.
+ * Presses are counted in bus->dropped if the queue is full.
+ */
+void SYNCMSG_press(SYNCMSG_BUS *, unsigned char, uint32_t);
+
+/**
+ * Function: bool SYNCMSG_node_edge(SYNCMSG_BUS *bus, unsigned char edge)
+ *
+ * Interrupt handler, nodes only: handle a falling clock edge at coarse timebase
+ * time edge (TIMEBASE_COARSE). Returns true if the edge is the tick (the first
+ * edge after a gap), and then SYNCMSG_node_tick() must be called next. Other
+ * edges advance the bus position by one bit. Call SYNCMSG_node_bit() last.
+ */
+bool SYNCMSG_node_edge(SYNCMSG_BUS *, unsigned char);
+
+/**
+ * Function: void SYNCMSG_node_tick(SYNCMSG_BUS *bus, uint32_t now)
+ *
+ * Interrupt handler, nodes only: start a tick period at a tick clock edge
+ * timestamped at timebase time now. The timestamp is turned into the tick time
+ * by SYNCMSG_poll().
+ */
+void SYNCMSG_node_tick(SYNCMSG_BUS *, uint32_t);
+
+/**
+ * Function: void SYNCMSG_node_bit(SYNCMSG_BUS *bus, bool level)
+ *
+ * Interrupt handler, nodes only: receive the master header bit from the data
+ * line level after a clock edge, and prepare bus->dataOut, this board's data
+ * output for the next bit clock period (true releases the line, false drives
+ * it low). Set the data output from bus->dataOut first at the next edge.
+ */
+void SYNCMSG_node_bit(SYNCMSG_BUS *, bool);
+
+/**
+ * Function: void SYNCMSG_master_bit(SYNCMSG_BUS *bus, bool level)
+ *
+ * Interrupt handler, master only: after the clock edge (if any) of a bit clock
+ * period, receive the node bit of the period before from the data line level,
+ * sampled at the start of the handler. Then move to the new bit clock period
+ * and prepare bus->dataOut, the master's data output for the next one. At the
+ * start of the next period, set the data output from bus->dataOut, then make
+ * a clock edge if bus->bit is SYNCBUS_PERIOD_BITS - 1 (the tick, also call
+ * SYNCMSG_master_tick()) or less than SYNCBUS_BURST_BITS - 1.
+ */
+void SYNCMSG_master_bit(SYNCMSG_BUS *, bool);
+
+/**
+ * Function: void SYNCMSG_master_tick(SYNCMSG_BUS *bus, uint32_t now)
+ *
+ * Interrupt handler, master only: start a tick period at the tick clock edge,
+ * made at timebase time now. Call SYNCMSG_master_bit() after it.
+ */
+void SYNCMSG_master_tick(SYNCMSG_BUS *, uint32_t);
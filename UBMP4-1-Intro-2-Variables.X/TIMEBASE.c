@@ -0,0 +1,78 @@
+/*==============================================================================
+ File: TIMEBASE.c
+ Date: October 18, 2026
+
+ UBMP4.1 (PIC16F1459) free-running 32-bit timestamp timer using Timer1
+
+ Include TIMEBASE.h in your main program to call these functions.
+==============================================================================*/
+
+#include    "xc.h"              // XC compiler general include file
+
+#include    "stdint.h"          // Include integer definitions
+#include    "stdbool.h"         // Include Boolean (true/false) definitions
+
+#include    "UBMP410.h"         // Include UBMP4.1 constant and function definitions
+#include    "TIMEBASE.h"        // Include timebase constant and function definitions
+
+// Upper 16 bits of the timestamp, counted by Timer1 overflows
+volatile unsigned int timebaseHigh = 0;
+
+// Configure Timer1 for 1.5 MHz counting and enable its overflow interrupt.
+void TIMEBASE_config(void)
+{
+    T1CON = 0b00110000;         // Fosc/4 clock, 1:8 prescaler, Timer1 off
+    T1GCON = 0b00000000;        // Timer1 gate disabled, always counting
+    TMR1H = 0;
+    TMR1L = 0;
+    timebaseHigh = 0;
+    TMR1IF = 0;
+    TMR1IE = 1;
+    PEIE = 1;                   // Enable peripheral interrupts
+    GIE = 1;                    // Enable global interrupts
+    TMR1ON = 1;                 // Start Timer1
+}
+
+// Return the current 32-bit timestamp. The read is repeated if an overflow is
+// counted by the ISR while reading, and an overflow that is still pending (eg.
+// when called from the ISR) is added if the count has just wrapped around.
+uint32_t TIMEBASE_ticks(void)
+{
+    unsigned int high;
+    unsigned char countH;
+    unsigned char countL;
+    bool overflow;
+
+    do
+    {
+        high = timebaseHigh;
+        do
+        {
+            countH = TMR1H;
+            countL = TMR1L;
+        } while(countH != TMR1H);   // Re-read if TMR1L carried into TMR1H
+        overflow = TMR1IF;
+    } while(high != timebaseHigh);
+
+    if(overflow && countH < 0x80)
+    {
+        high++;
+    }
+    return (((uint32_t)high << 16) | ((unsigned int)countH << 8) | countL);
+}
+
+// Convert timer ticks (2/3 us each) to microseconds.
+uint32_t TIMEBASE_us(uint32_t ticks)
+{
+    return (ticks - ticks / 3);
+}
+
+// Timer1 overflow interrupt handler (call from the ISR).
+void TIMEBASE_isr(void)
+{
+    if(TMR1IE && TMR1IF)
+    {
+        TMR1IF = 0;
+        timebaseHigh++;
+    }
+}
@@ -0,0 +1,59 @@
+/*==============================================================================
+ File: TIMEBASE.h
+ Date: October 18, 2026
+
+ UBMP4.1 (PIC16F1459) free-running timestamp timer constant definitions and
+ function prototypes
+
+ Timer1 counts Fosc/4 (12 MHz) through a 1:8 prescaler, giving 1.5 MHz ticks
+ (0.667 us resolution). Timer1 overflows are counted by TIMEBASE_isr() to
+ extend the count to 32 bits, which wraps around after about 47 minutes.
+ Timestamps are kept in ticks and converted to microseconds only when needed,
+ since conversion requires a division.
+==============================================================================*/
+
+// Timebase tick rate definitions
+#define TIMEBASE_TICKS_PER_MS   1500    // Timer ticks per millisecond
+#define TIMEBASE_DEBOUNCE_TICKS (20UL * TIMEBASE_TICKS_PER_MS)  // Pushbutton debounce
+
+// Coarse timestamp: bits 8-15 of the timestamp (units of 256 ticks, wrapping
+// every 44 ms), read in one instruction for timing short intervals in an
+// interrupt handler.
+#define TIMEBASE_COARSE         TMR1H
+
+// Prototypes for TIMEBASE.c functions:
+
+/**
+ * Function: void TIMEBASE_config(void)
+ *
+ * Configure and start Timer1 as the free-running timebase and enable the Timer1
+ * overflow interrupt.
+ */
+void TIMEBASE_config(void);
+
+/**
+ * Function: uint32_t TIMEBASE_ticks(void)
+ *
+ * Return the current 32-bit timestamp in timer ticks. Can be called from the
+ * main program or from the interrupt service routine.
+ *
+ * Example usage: pressTime = TIMEBASE_ticks();
+ */
+uint32_t TIMEBASE_ticks(void);
+
+/**
+ * Function: uint32_t TIMEBASE_us(uint32_t ticks)
+ *
+ * Convert a timestamp or time difference from timer ticks to microseconds.
+ *
+ * Example usage: reactionTime = TIMEBASE_us(pressTime - cueTime);
+ */
+uint32_t TIMEBASE_us(uint32_t);
+
+/**
+ * Function: void TIMEBASE_isr(void)
+ *
+ * Timer1 overflow interrupt handler. Call this function from the main
+ * program's interrupt service routine.
+ */
+void TIMEBASE_isr(void);
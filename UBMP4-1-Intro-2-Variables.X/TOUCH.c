@@ -0,0 +1,324 @@
+/*==============================================================================
+ File: TOUCH.c
+ Date: October 18, 2026
+
+ UBMP4.1 (PIC16F1459) capacitive voltage divider (CVD) touch sensing engine
+
+ Each key measurement is split into three interrupt-driven steps so that the
+ ADC conversions run in the background:
+ 1. Timer2: discharge the key, charge the ADC hold capacitor from the previous
+    key's pin, connect the key to the ADC and start the first conversion.
+ 2. ADC: charge the key, discharge the hold capacitor, connect the key to the
+    ADC and start the second (reversed) conversion.
+ 3. ADC: subtract the conversions and update the key's baseline and state.
+ Include TOUCH.h in your main program to call these functions.
+==============================================================================*/
+
+#include    "xc.h"              // XC compiler general include file
+
+#include    "stdint.h"          // Include integer definitions
+#include    "stdbool.h"         // Include Boolean (true/false) definitions
+
+#include    "UBMP410.h"         // Include UBMP4.1 constant and function definitions
+#include    "TOUCH.h"           // Include touch sensing constant and function definitions
+
+// ADC channel select values for each PORTC bit (0 for pins without a touch key)
+const unsigned char touchChannel[8] = {ANH1, ANH2, ANH3, ANH4, 0, 0, ANH7, ANH8};
+
+// Touch engine state
+unsigned char touchKeys = 0;        // Enabled keys
+volatile unsigned char touchState = 0;  // Touched keys
+unsigned char touchKey = 0;         // Key being measured
+unsigned char touchIndex = 0;       // PORTC bit number of key being measured
+unsigned char touchRef = 0;         // Key used to pre-charge the ADC
+unsigned char touchRefIndex = 0;    // PORTC bit number of reference key
+unsigned char touchStep = 0;        // Measurement step (0 - 2)
+unsigned int touchFirst;            // First (forward) conversion result
+volatile unsigned int touchCount = 0;   // Completed measurements
+
+// Per-key state, indexed by PORTC bit number. Baselines are stored as 16 times
+// the measurement, and the upward drift filter keeps the remainder of each
+// update, so that differences of less than one count still move the baseline.
+unsigned int touchBase[8];          // Baseline (x16)
+unsigned int touchDriftFrac[8];     // Upward drift remainder (x16 counts)
+int touchSignal[8];                 // Measurement minus baseline
+unsigned char touchCalibrate[8];    // Calibration scans remaining
+unsigned char touchDebounce[8];     // Consecutive scans beyond threshold
+unsigned int touchOnScans[8];       // Scans since key was touched
+
+// Configure the ADC and Timer2 and start scanning the specified touch keys.
+bool TOUCH_config(unsigned char keys)
+{
+    unsigned char count = 0;
+    unsigned char key;
+
+    keys &= TOUCH_ALL;
+    for(key = 1; key != 0; key <<= 1)
+    {
+        if(keys & key)
+        {
+            count++;
+        }
+    }
+    if(count < 2)
+    {
+        return (false);         // CVD needs another key to pre-charge the ADC
+    }
+
+    TMR2IE = 0;                 // Stop any previous scan
+    ADIE = 0;
+    touchKeys = keys;
+    touchState = 0;
+    touchStep = 0;
+    touchKey = 0b10000000;      // Start from the highest key, so that it becomes
+    touchIndex = 7;             // the reference for the first (lowest) key
+    while((touchKey & keys) == 0)
+    {
+        touchKey >>= 1;
+        touchIndex--;
+    }
+    TOUCH_calibrate();
+
+    // Drive all touch keys low. Keys are only inputs while being converted.
+    LATC = LATC & ~keys;
+    TRISC = TRISC & ~keys;
+    ANSELC = ANSELC | keys;     // Disconnect digital input buffers
+
+    // General ADC setup and configuration
+    ADCON1 = 0b01100000;        // Left justified result, FOSC/64 clock, +VDD ref
+    ADCON2 = 0b00000000;        // Auto-conversion trigger disabled
+    ADCON0 = touchChannel[0] | 0b00000001;  // Turn the A-D converter on
+    ADIF = 0;
+    ADIE = 1;
+
+    // Timer2: 12 MHz / 16 prescaler / (249 + 1) / 3 postscaler = 1000 Hz
+    PR2 = 249;
+    TMR2 = 0;
+    T2CON = 0b00010110;         // 1:3 postscaler, Timer2 on, 1:16 prescaler
+    TMR2IF = 0;
+    TMR2IE = 1;
+    PEIE = 1;                   // Enable peripheral interrupts
+    GIE = 1;                    // Enable global interrupts
+    return (true);
+}
+
+// Re-measure the baselines of all keys over their next 16 scans.
+void TOUCH_calibrate(void)
+{
+    unsigned char i;
+
+    ADIE = 0;                   // Hold off baseline updates
+    for(i = 0; i != 8; i++)
+    {
+        touchBase[i] = 0;
+        touchDriftFrac[i] = 0;
+        touchSignal[i] = 0;
+        touchCalibrate[i] = 16;
+        touchDebounce[i] = 0;
+        touchOnScans[i] = 0;
+    }
+    touchState = 0;
+    if(touchKeys != 0)
+    {
+        ADIE = 1;
+    }
+}
+
+// Return the touched state of all keys.
+unsigned char TOUCH_keys(void)
+{
+    return (touchState);
+}
+
+// Return the PORTC bit number of a single touch key.
+static unsigned char touch_index(unsigned char key)
+{
+    unsigned char index = 0;
+
+    while(key > 1)
+    {
+        key >>= 1;
+        index++;
+    }
+    return (index);
+}
+
+// Return the most recent signal of a single key.
+int TOUCH_signal(unsigned char key)
+{
+    int signal;
+
+    ADIE = 0;                   // Prevent the ISR changing the value mid-read
+    signal = touchSignal[touch_index(key)];
+    ADIE = (touchKeys != 0);
+    return (signal);
+}
+
+// Return the current baseline measurement of a single key.
+unsigned int TOUCH_baseline(unsigned char key)
+{
+    unsigned int base;
+
+    ADIE = 0;                   // Prevent the ISR changing the value mid-read
+    base = touchBase[touch_index(key)] >> 4;
+    ADIE = (touchKeys != 0);
+    return (base);
+}
+
+// Return the free-running count of completed key measurements.
+unsigned int TOUCH_scans(void)
+{
+    unsigned int count;
+
+    ADIE = 0;                   // Prevent the ISR changing the value mid-read
+    count = touchCount;
+    ADIE = (touchKeys != 0);
+    return (count);
+}
+
+// Read the 10-bit result of the last conversion from the left justified result.
+static unsigned int touch_result(void)
+{
+    return (((unsigned int)ADRESH << 2) | (ADRESL >> 6));
+}
+
+// Update the baseline, signal and touched state of the measured key.
+static void touch_update(unsigned int measurement)
+{
+    unsigned char i = touchIndex;
+    int signal;
+    int drift;
+
+    if(touchCalibrate[i] != 0)
+    {
+        touchBase[i] += measurement;    // Sum of 16 scans is the x16 baseline
+        touchCalibrate[i]--;
+        return;
+    }
+
+    signal = (int)measurement - (int)(touchBase[i] >> 4);
+    touchSignal[i] = signal;
+
+    if(touchState & touchKey)
+    {
+        // Touched: baseline is frozen. Release below the lower threshold.
+        if(signal < TOUCH_RELEASE_THRESHOLD)
+        {
+            if(++touchDebounce[i] >= TOUCH_DEBOUNCE)
+            {
+                touchDebounce[i] = 0;
+                touchState &= ~touchKey;
+            }
+        }
+        else
+        {
+            touchDebounce[i] = 0;
+        }
+        if(++touchOnScans[i] >= TOUCH_MAX_ON_SCANS)
+        {
+            touchBase[i] = 0;   // Stuck key, re-calibrate it
+            touchDriftFrac[i] = 0;
+            touchCalibrate[i] = 16;
+            touchDebounce[i] = 0;
+            touchState &= ~touchKey;
+        }
+        return;
+    }
+
+    // Not touched: detect touches above the higher threshold.
+    if(signal >= TOUCH_PRESS_THRESHOLD)
+    {
+        if(++touchDebounce[i] >= TOUCH_DEBOUNCE)
+        {
+            touchDebounce[i] = 0;
+            touchOnScans[i] = 0;
+            touchState |= touchKey;
+        }
+        return;
+    }
+    touchDebounce[i] = 0;
+
+    // Compensate for drift unless the signal could be an approaching touch.
+    if(signal < TOUCH_RELEASE_THRESHOLD)
+    {
+        drift = (int)(measurement << 4) - (int)touchBase[i];
+        if(drift < 0)
+        {
+            drift >>= TOUCH_DRIFT_DOWN_SHIFT;
+            touchDriftFrac[i] = 0;
+        }
+        else
+        {
+            touchDriftFrac[i] += (unsigned int)drift;
+            drift = (int)(touchDriftFrac[i] >> TOUCH_DRIFT_UP_SHIFT);
+            touchDriftFrac[i] &= (1 << TOUCH_DRIFT_UP_SHIFT) - 1;
+        }
+        touchBase[i] += drift;
+    }
+}
+
+// Touch scanning interrupt handler (call from the ISR).
+void TOUCH_isr(void)
+{
+    unsigned int second;
+
+    // Step 1: select the next key and start the forward conversion.
+    if(touchKeys != 0 && TMR2IE && TMR2IF)
+    {
+        TMR2IF = 0;
+        if(touchStep != 0)
+        {
+            return;             // Previous measurement is still converting
+        }
+        touchRef = touchKey;        // Previous key becomes the reference
+        touchRefIndex = touchIndex;
+        do
+        {
+            touchKey <<= 1;
+            touchIndex++;
+            if(touchKey == 0)
+            {
+                touchKey = 1;
+                touchIndex = 0;
+            }
+        } while((touchKey & touchKeys) == 0);
+
+        LATC = LATC | touchRef;     // Charge hold capacitor from reference key
+        ADCON0 = touchChannel[touchRefIndex] | 0b00000001;
+        __delay_us(2);
+        ADCON0 = touchChannel[touchIndex] | 0b00000001;
+        TRISC = TRISC | touchKey;   // Connect discharged key to hold capacitor
+        LATC = LATC & ~touchRef;
+        GO = 1;
+        touchStep = 1;
+    }
+
+    if(ADIE && ADIF)
+    {
+        ADIF = 0;
+        // Step 2: reverse the pre-charge levels and start the second conversion.
+        if(touchStep == 1)
+        {
+            touchFirst = touch_result();
+            LATC = LATC | touchKey;     // Charge key
+            TRISC = TRISC & ~touchKey;
+            ADCON0 = touchChannel[touchRefIndex] | 0b00000001;
+            __delay_us(2);              // Discharge hold capacitor
+            ADCON0 = touchChannel[touchIndex] | 0b00000001;
+            TRISC = TRISC | touchKey;   // Connect charged key to hold capacitor
+            GO = 1;
+            touchStep = 2;
+        }
+        // Step 3: guard the key and update its state. The second result rises
+        // and the first result falls as key capacitance increases.
+        else if(touchStep == 2)
+        {
+            second = touch_result();
+            LATC = LATC & ~touchKey;
+            TRISC = TRISC & ~touchKey;
+            touch_update(1023 + second - touchFirst);
+            touchCount++;
+            touchStep = 0;
+        }
+    }
+}
@@ -0,0 +1,125 @@
+/*==============================================================================
+ File: TOUCH.h
+ Date: October 18, 2026
+
+ UBMP4.1 (PIC16F1459) capacitive touch sensing constant definitions and
+ function prototypes
+
+ Operation:
+ Header pins H1-H4, H7 and H8 are connected to ADC channels and can be used as
+ capacitive touch keys using capacitive voltage divider (CVD) measurements -
+ connect a wire, pad, or piece of foil to the header pin. Each measurement
+ pre-charges the ADC sample and hold capacitor and the touch key to opposite
+ levels, connects them together, and converts the shared voltage. Touching the
+ key adds capacitance, which changes the shared voltage. Two measurements with
+ reversed pre-charge levels are subtracted to reject noise and supply changes.
+
+ The pin of the previously measured key is used as the ADC pre-charge source,
+ so at least two keys must be enabled. Keys that are not being measured are
+ driven low to act as guards. H4 is shared with phototransistor Q1, H3 with IR
+ demodulator U2, and H7 and H8 with LEDs D5 and D6, so those keys will have
+ larger baselines and more noise (and their LEDs stay off) while in use.
+
+ Scanning:
+ Timer2 starts the measurement of one key every 1 ms, and the ADC interrupt
+ completes it in the background. Each key is scanned at 1000 Hz divided by the
+ number of enabled keys (500 Hz for two keys, 166 Hz for all six keys).
+
+ Each key tracks its own baseline. The baseline follows slow upward drift
+ slowly (even drift of less than one count, which is accumulated between
+ scans) and downward drift quickly while the key is not touched, and is frozen
+ while the key is touched. A key is reported as touched after its signal stays
+ above TOUCH_PRESS_THRESHOLD for TOUCH_DEBOUNCE scans, and released after its
+ signal stays below the lower TOUCH_RELEASE_THRESHOLD for TOUCH_DEBOUNCE scans.
+ A key that stays touched for longer than TOUCH_MAX_ON_SCANS is re-calibrated.
+
+ CPU load (estimated at 48 MHz for each 1 ms Timer2 period):
+   Timer2 interrupt (pre-charge and start conversion)      5 us
+   First ADC interrupt (reverse pre-charge and start)      5 us
+   Second ADC interrupt (baseline, hysteresis, debounce)   8 us
+   Total: approximately 18 us per ms, or 1.8% of the CPU, independent of the
+   number of enabled keys. The ADC conversions themselves (15 us each) run in
+   the background. TOUCH_scans() can be used to check the scan rate.
+
+ The touch engine uses the ADC, Timer2 and the ADC and Timer2 interrupts. Do
+ not use the ADC functions in UBMP410.c while touch sensing is enabled.
+==============================================================================*/
+
+// Touch key definitions. Key values match their PORTC bit positions and can be
+// combined to enable multiple keys or to test the touched key state.
+#define TOUCH_H1    0b00000001      // H1 header touch key (RC0/AN4)
+#define TOUCH_H2    0b00000010      // H2 header touch key (RC1/AN5)
+#define TOUCH_H3    0b00000100      // H3 header touch key (RC2/AN6)
+#define TOUCH_H4    0b00001000      // H4 header touch key (RC3/AN7)
+#define TOUCH_H7    0b01000000      // H7 header touch key (RC6/AN8)
+#define TOUCH_H8    0b10000000      // H8 header touch key (RC7/AN9)
+#define TOUCH_ALL   0b11001111      // All touch keys
+
+// Touch detection settings (signal values are in 10-bit ADC counts)
+#define TOUCH_PRESS_THRESHOLD   40  // Signal above baseline to detect a touch
+#define TOUCH_RELEASE_THRESHOLD 24  // Signal above baseline to stay touched
+#define TOUCH_DEBOUNCE          3   // Consecutive scans to change key state
+#define TOUCH_MAX_ON_SCANS      2000 // Re-calibrate keys touched this long
+#define TOUCH_DRIFT_UP_SHIFT    8   // Baseline filter shift for upward drift
+#define TOUCH_DRIFT_DOWN_SHIFT  3   // Baseline filter shift for downward drift
+
+// Prototypes for TOUCH.c functions:
+
+/**
+ * Function: bool TOUCH_config(unsigned char keys)
+ *
+ * Configure the ADC and Timer2 for touch sensing and start scanning the keys
+ * specified by the combined touch key constants above. Returns false if fewer
+ * than two keys are specified.
+ *
+ * Example usage: TOUCH_config(TOUCH_H1 | TOUCH_H2);
+ */
+bool TOUCH_config(unsigned char);
+
+/**
+ * Function: void TOUCH_calibrate(void)
+ *
+ * Re-measure the baselines of all keys by averaging their next 16 scans (do
+ * not touch the keys while they are being calibrated).
+ */
+void TOUCH_calibrate(void);
+
+/**
+ * Function: unsigned char TOUCH_keys(void)
+ *
+ * Return the touched state of all keys as combined touch key constants.
+ *
+ * Example usage: if(TOUCH_keys() & TOUCH_H1) LED5 = 1;
+ */
+unsigned char TOUCH_keys(void);
+
+/**
+ * Function: int TOUCH_signal(unsigned char key)
+ *
+ * Return the most recent signal (measurement minus baseline) of a single key.
+ *
+ * Example usage: strength = TOUCH_signal(TOUCH_H2);
+ */
+int TOUCH_signal(unsigned char);
+
+/**
+ * Function: unsigned int TOUCH_baseline(unsigned char key)
+ *
+ * Return the current baseline measurement of a single key.
+ */
+unsigned int TOUCH_baseline(unsigned char);
+
+/**
+ * Function: unsigned int TOUCH_scans(void)
+ *
+ * Return the free-running count of completed key measurements.
+ */
+unsigned int TOUCH_scans(void);
+
+/**
+ * Function: void TOUCH_isr(void)
+ *
+ * Touch scanning interrupt handler. Call this function from the main program's
+ * interrupt service routine.
+ */
+void TOUCH_isr(void);
@@ -0,0 +1,738 @@
+/*==============================================================================
+ File: USB_HID.c
+ Date: October 18, 2026
+
+ UBMP4.1 (PIC16F1459) minimal interrupt-driven USB HID keyboard/gamepad device
+
+ Endpoint 0 handles the standard and HID class control requests needed for
+ enumeration, and endpoint 1 IN sends input reports at a 1 ms polling interval.
+ Ping-pong buffering is disabled, so the buffer descriptor table (BDT) holds
+ one descriptor for each endpoint direction. The BDT and endpoint buffers are
+ placed in bank 0 of the USB dual-port RAM (linear address 0x2000), and the
+ SIE is given their linear addresses. Include USB_HID.h in your main program
+ to call these functions.
+==============================================================================*/
+
+#include    "xc.h"              // XC compiler general include file
+
+#include    "stdint.h"          // Include integer definitions
+#include    "stdbool.h"         // Include Boolean (true/false) definitions
+
+#include    "UBMP410.h"         // Include UBMP4.1 constant and function definitions
+#include    "TIMEBASE.h"        // Include timebase constant and function definitions
+#include    "USB_HID.h"         // Include USB HID constant and function definitions
+
+// Buffer descriptor STAT register bits
+#define BD_UOWN     0b10000000      // SIE owns the buffer
+#define BD_DTS      0b01000000      // DATA1 packet (DATA0 if clear)
+#define BD_DTSEN    0b00001000      // Data toggle synchronization enabled
+#define BD_BSTALL   0b00000100      // Stall the endpoint
+#define BD_PID(stat) (((stat) >> 2) & 0x0F)     // Token PID set by the SIE
+#define PID_SETUP   0x0D            // SETUP token PID
+
+// Buffer descriptor table indexes (ping-pong disabled: USTAT >> 2)
+#define BD_EP0_OUT  0
+#define BD_EP0_IN   1
+#define BD_EP1_IN   3
+
+// Endpoint buffer linear addresses in USB dual-port RAM
+#define EP0_OUT_ADDR    0x2010
+#define EP0_IN_ADDR     0x2018
+#define EP1_IN_ADDR     0x2020
+#define EP0_SIZE        8           // Endpoint 0 maximum packet size
+#define EP1_SIZE        8           // Endpoint 1 maximum packet size
+
+// Control transfer states
+#define CTRL_IDLE       0           // Waiting for a SETUP packet
+#define CTRL_DATA_IN    1           // Sending data to the host
+#define CTRL_STATUS_IN  2           // Sending zero-length status packet
+#define CTRL_STATUS_OUT 3           // Waiting for host zero-length status
+
+// Buffer descriptor
+typedef struct
+{
+    unsigned char STAT;
+    unsigned char CNT;
+    unsigned char ADRL;
+    unsigned char ADRH;
+} USB_BD;
+
+// BDT and endpoint buffers at fixed banked addresses in bank 0 (linear 0x2000)
+volatile USB_BD usbBD[4] __at(0x20);
+volatile unsigned char ep0Out[EP0_SIZE] __at(0x30);
+volatile unsigned char ep0In[EP0_SIZE] __at(0x38);
+volatile unsigned char ep1In[EP1_SIZE] __at(0x40);
+
+// HID report descriptors
+#if USB_HID_TYPE == USB_HID_KEYBOARD
+#define HID_SUBCLASS    1           // Boot interface subclass
+#define HID_PROTOCOL    1           // Keyboard
+#define HID_REPORT_SIZE 8
+const unsigned char reportDescriptor[] = {
+    0x05, 0x01,         // Usage Page (Generic Desktop)
+    0x09, 0x06,         // Usage (Keyboard)
+    0xA1, 0x01,         // Collection (Application)
+    0x05, 0x07,         //   Usage Page (Keyboard/Keypad)
+    0x19, 0xE0,         //   Usage Minimum (Left Control)
+    0x29, 0xE7,         //   Usage Maximum (Right GUI)
+    0x15, 0x00,         //   Logical Minimum (0)
+    0x25, 0x01,         //   Logical Maximum (1)
+    0x75, 0x01,         //   Report Size (1)
+    0x95, 0x08,         //   Report Count (8)
+    0x81, 0x02,         //   Input (Data, Variable, Absolute) - modifiers
+    0x95, 0x01,         //   Report Count (1)
+    0x75, 0x08,         //   Report Size (8)
+    0x81, 0x01,         //   Input (Constant) - reserved byte
+    0x95, 0x06,         //   Report Count (6)
+    0x75, 0x08,         //   Report Size (8)
+    0x15, 0x00,         //   Logical Minimum (0)
+    0x25, 0x65,         //   Logical Maximum (101)
+    0x19, 0x00,         //   Usage Minimum (0)
+    0x29, 0x65,         //   Usage Maximum (101)
+    0x81, 0x00,         //   Input (Data, Array) - key codes
+    0xC0                // End Collection
+};
+
+// Key codes sent for each input bit (Z, X, C, V, 1, 2, 3, 4)
+const unsigned char hidKeyCodes[8] = {0x1D, 0x1B, 0x06, 0x19, 0x1E, 0x1F, 0x20, 0x21};
+#else
+#define HID_SUBCLASS    0           // No subclass
+#define HID_PROTOCOL    0           // No protocol
+#define HID_REPORT_SIZE 3
+const unsigned char reportDescriptor[] = {
+    0x05, 0x01,         // Usage Page (Generic Desktop)
+    0x09, 0x05,         // Usage (Game Pad)
+    0xA1, 0x01,         // Collection (Application)
+    0x05, 0x09,         //   Usage Page (Button)
+    0x19, 0x01,         //   Usage Minimum (Button 1)
+    0x29, 0x08,         //   Usage Maximum (Button 8)
+    0x15, 0x00,         //   Logical Minimum (0)
+    0x25, 0x01,         //   Logical Maximum (1)
+    0x75, 0x01,         //   Report Size (1)
+    0x95, 0x08,         //   Report Count (8)
+    0x81, 0x02,         //   Input (Data, Variable, Absolute) - buttons
+    0x06, 0x00, 0xFF,   //   Usage Page (Vendor Defined 0xFF00)
+    0x09, 0x01,         //   Usage (Vendor Usage 1) - latency in microseconds
+    0x27, 0xFF, 0xFF, 0x00, 0x00,   // Logical Maximum (65535)
+    0x75, 0x10,         //   Report Size (16)
+    0x95, 0x01,         //   Report Count (1)
+    0x81, 0x02,         //   Input (Data, Variable, Absolute)
+    0xC0                // End Collection
+};
+#endif
+
+// Device descriptor
+const unsigned char deviceDescriptor[18] = {
+    18, 0x01,           // Length, DEVICE descriptor
+    0x00, 0x02,         // USB 2.0
+    0x00, 0x00, 0x00,   // Class defined by interface
+    EP0_SIZE,           // Endpoint 0 maximum packet size
+    (unsigned char)USB_HID_VID, (unsigned char)(USB_HID_VID >> 8),
+    (unsigned char)USB_HID_PID, (unsigned char)(USB_HID_PID >> 8),
+    0x00, 0x01,         // Device release 1.00
+    1, 2, 0,            // Manufacturer, product, (no) serial number strings
+    1                   // One configuration
+};
+
+// Configuration, interface, HID and endpoint descriptors
+const unsigned char configDescriptor[34] = {
+    9, 0x02, 34, 0,     // Length, CONFIGURATION descriptor, total length
+    1, 1, 0,            // One interface, configuration 1, no string
+    0x80, 50,           // Bus powered, 100 mA
+    9, 0x04, 0, 0,      // Length, INTERFACE descriptor, interface 0, alt. 0
+    1, 0x03,            // One endpoint, HID class
+    HID_SUBCLASS, HID_PROTOCOL, 0,
+    9, 0x21, 0x11, 0x01,    // Length, HID descriptor, HID 1.11
+    0, 1, 0x22,         // No country, one REPORT descriptor
+    sizeof(reportDescriptor), 0,
+    7, 0x05, 0x81,      // Length, ENDPOINT descriptor, endpoint 1 IN
+    0x03, EP1_SIZE, 0,  // Interrupt endpoint, maximum packet size
+    1                   // 1 ms polling interval
+};
+#define HID_DESCRIPTOR_OFFSET 18    // HID descriptor within configDescriptor
+
+// String descriptors (UTF-16LE)
+const unsigned char string0Descriptor[4] = {4, 0x03, 0x09, 0x04};  // US English
+const unsigned char string1Descriptor[24] = {24, 0x03,
+    'm', 0, 'i', 0, 'r', 0, 'o', 0, 'b', 0, 'o', 0, '.', 0, 't', 0, 'e', 0,
+    'c', 0, 'h', 0};
+const unsigned char string2Descriptor[20] = {20, 0x03,
+    'U', 0, 'B', 0, 'M', 0, 'P', 0, '4', 0, ' ', 0, 'H', 0, 'I', 0, 'D', 0};
+
+// USB device state
+bool hidActive = false;             // USB HID mode owns the pushbutton interrupts
+bool usbConfigured = false;
+unsigned char usbAddress = 0;       // Address to set after SET_ADDRESS status
+unsigned char hidIdle = 0;          // HID idle rate (reports are sent on change)
+unsigned char hidProtocol = 1;      // HID protocol (0 = boot, 1 = report)
+
+// Control transfer state
+unsigned char ctrlState = CTRL_IDLE;
+const unsigned char *ctrlData;      // Next descriptor byte to send
+unsigned char ctrlLength;           // Descriptor bytes left to send
+bool ctrlZeroLength;                // End data stage with a zero-length packet
+bool ctrlDTS;                       // Next endpoint 0 IN data toggle
+unsigned char ctrlReply[2];         // Reply data for status requests
+
+// HID input state
+volatile unsigned char hidInputs = 0;   // Debounced inputs (bit set = pressed)
+unsigned char hidLockout[8];        // Debounce lock-out time left (ms)
+bool ep1DTS = false;                // Next endpoint 1 IN data toggle
+bool reportPending = false;         // Inputs changed while endpoint 1 was busy
+
+// Press-to-report latency measurement
+uint32_t pressTime;                 // Time of the earliest unreported press
+bool pressPending = false;
+uint32_t sentPressTime;             // Press time of the report being sent
+bool sentPress = false;
+volatile unsigned int latencyTicks = 0;     // Most recent latency
+volatile unsigned int latencyMaxTicks = 0;  // Longest latency
+unsigned int latencyReportUs = 0;   // Most recent latency for gamepad reports
+
+// Set up a buffer descriptor for the SIE.
+static void usb_bd_arm(unsigned char bd, unsigned char count, unsigned char stat)
+{
+    usbBD[bd].CNT = count;
+    usbBD[bd].STAT = stat | BD_UOWN;    // STAT must be written last
+}
+
+// Arm endpoint 0 OUT for the next SETUP or status packet.
+static void usb_ep0_receive(void)
+{
+    usb_bd_arm(BD_EP0_OUT, EP0_SIZE, 0);
+}
+
+// Send the next packet of the control transfer data stage.
+static void usb_ep0_send_data(void)
+{
+    unsigned char count = EP0_SIZE;
+    unsigned char i;
+
+    if(ctrlLength < EP0_SIZE)
+    {
+        count = ctrlLength;
+    }
+    for(i = 0; i != count; i++)
+    {
+        ep0In[i] = ctrlData[i];
+    }
+    ctrlData += count;
+    ctrlLength -= count;
+    usb_bd_arm(BD_EP0_IN, count, BD_DTSEN | (ctrlDTS ? BD_DTS : 0));
+    ctrlDTS = !ctrlDTS;
+}
+
+// Start a control IN data stage, limited to the host's requested length.
+static void usb_ep0_reply(const unsigned char *data, unsigned char length, unsigned int requested)
+{
+    if(requested < length)
+    {
+        length = (unsigned char)requested;
+    }
+    ctrlData = data;
+    ctrlLength = length;
+    ctrlZeroLength = (length < requested && (length % EP0_SIZE) == 0);
+    ctrlDTS = true;             // Data stage starts with DATA1
+    ctrlState = CTRL_DATA_IN;
+    usb_ep0_send_data();
+}
+
+// Acknowledge a control transfer without a data stage.
+static void usb_ep0_status(void)
+{
+    usb_bd_arm(BD_EP0_IN, 0, BD_DTSEN | BD_DTS);
+    ctrlState = CTRL_STATUS_IN;
+}
+
+// Stall an unsupported control request. The stall is cleared by the next SETUP.
+static void usb_ep0_stall(void)
+{
+    usb_bd_arm(BD_EP0_IN, 0, BD_BSTALL);
+    ctrlState = CTRL_IDLE;
+}
+
+// Build the input report from the current inputs and send it on endpoint 1,
+// or mark it as pending if the previous report has not been sent yet.
+static void hid_send_report(void)
+{
+    unsigned char inputs = hidInputs;
+#if USB_HID_TYPE == USB_HID_KEYBOARD
+    unsigned char key = 2;
+    unsigned char i;
+#endif
+
+    if(!usbConfigured)
+    {
+        return;
+    }
+    if(usbBD[BD_EP1_IN].STAT & BD_UOWN)
+    {
+        reportPending = true;   // Send the latest inputs when the SIE is done
+        return;
+    }
+#if USB_HID_TYPE == USB_HID_KEYBOARD
+    for(i = 0; i != HID_REPORT_SIZE; i++)
+    {
+        ep1In[i] = 0;
+    }
+    for(i = 0; i != 8; i++)
+    {
+        if(inputs & (1 << i))
+        {
+            if(key == HID_REPORT_SIZE)
+            {
+                for(key = 2; key != HID_REPORT_SIZE; key++)
+                {
+                    ep1In[key] = 0x01;  // Too many keys - roll-over error
+                }
+                break;
+            }
+            ep1In[key++] = hidKeyCodes[i];
+        }
+    }
+#else
+    ep1In[0] = inputs;
+    ep1In[1] = (unsigned char)latencyReportUs;
+    ep1In[2] = (unsigned char)(latencyReportUs >> 8);
+#endif
+    reportPending = false;
+    sentPress = pressPending;
+    sentPressTime = pressTime;
+    pressPending = false;
+    usb_bd_arm(BD_EP1_IN, HID_REPORT_SIZE, BD_DTSEN | (ep1DTS ? BD_DTS : 0));
+    ep1DTS = !ep1DTS;
+}
+
+// Update the debounced inputs from a sample of the (active-low) input pins.
+// Only inputs listed in candidates, and not in their lock-out time, can change.
+static void hid_inputs_update(unsigned char sample, unsigned char candidates, uint32_t time)
+{
+    unsigned char changed;
+    unsigned char i;
+
+    changed = (sample ^ hidInputs) & candidates;
+    if(changed == 0)
+    {
+        return;
+    }
+    for(i = 0; i != 8; i++)
+    {
+        if((changed & (1 << i)) && hidLockout[i] == 0)
+        {
+            hidInputs ^= (1 << i);
+            hidLockout[i] = USB_HID_DEBOUNCE_MS + 1;
+            if((sample & (1 << i)) && !pressPending)
+            {
+                pressTime = time;
+                pressPending = true;
+            }
+        }
+    }
+    hid_send_report();
+}
+
+// Return the pressed state of the pushbuttons and enabled header inputs.
+static unsigned char hid_sample(void)
+{
+    return (((~PORTB >> 4) & 0x0F) | ((~PORTC << 4) & (USB_HID_HEADERS << 4)));
+}
+
+// Reset the USB device state after a bus reset.
+static void usb_reset(void)
+{
+    UEIR = 0;
+    UIR = 0;
+    UADDR = 0;
+    usbAddress = 0;
+    usbConfigured = false;
+    ctrlState = CTRL_IDLE;
+    while(UIRbits.TRNIF)
+    {
+        UIRbits.TRNIF = 0;      // Flush the USTAT FIFO
+    }
+    UEP1 = 0;                   // Disable endpoint 1 until configured
+    UEP0 = 0b00010110;          // Endpoint 0: handshake, control, IN and OUT
+    usbBD[BD_EP0_OUT].ADRL = (unsigned char)EP0_OUT_ADDR;
+    usbBD[BD_EP0_OUT].ADRH = (unsigned char)(EP0_OUT_ADDR >> 8);
+    usbBD[BD_EP0_IN].STAT = 0;
+    usbBD[BD_EP0_IN].ADRL = (unsigned char)EP0_IN_ADDR;
+    usbBD[BD_EP0_IN].ADRH = (unsigned char)(EP0_IN_ADDR >> 8);
+    usbBD[BD_EP1_IN].STAT = 0;
+    usbBD[BD_EP1_IN].ADRL = (unsigned char)EP1_IN_ADDR;
+    usbBD[BD_EP1_IN].ADRH = (unsigned char)(EP1_IN_ADDR >> 8);
+    usb_ep0_receive();
+    UCONbits.PKTDIS = 0;        // Allow SETUP packets to be processed
+}
+
+// Handle a SETUP packet received on endpoint 0.
+static void usb_setup(void)
+{
+    unsigned char requestType = ep0Out[0];
+    unsigned char request = ep0Out[1];
+    unsigned char valueL = ep0Out[2];
+    unsigned char valueH = ep0Out[3];
+    unsigned char indexL = ep0Out[4];
+    unsigned int length = ep0Out[6] | ((unsigned int)ep0Out[7] << 8);
+
+    usbBD[BD_EP0_IN].STAT = 0;  // Cancel any unfinished control transfer
+    usb_ep0_receive();          // Re-arm for the status stage or next SETUP
+
+    // HID class requests to the interface
+    if(requestType == 0x21 || requestType == 0xA1)
+    {
+        if(request == 0x01)                 // GET_REPORT
+        {
+            usb_ep0_reply((const unsigned char *)ep1In, HID_REPORT_SIZE, length);
+        }
+        else if(request == 0x02)            // GET_IDLE
+        {
+            ctrlReply[0] = hidIdle;
+            usb_ep0_reply(ctrlReply, 1, length);
+        }
+        else if(request == 0x03)            // GET_PROTOCOL
+        {
+            ctrlReply[0] = hidProtocol;
+            usb_ep0_reply(ctrlReply, 1, length);
+        }
+        else if(request == 0x0A)            // SET_IDLE
+        {
+            hidIdle = valueH;
+            usb_ep0_status();
+        }
+        else if(request == 0x0B)            // SET_PROTOCOL
+        {
+            hidProtocol = valueL;
+            usb_ep0_status();
+        }
+        else
+        {
+            usb_ep0_stall();
+        }
+    }
+    // Standard requests
+    else if(request == 0x06)                // GET_DESCRIPTOR
+    {
+        if(valueH == 0x01)
+        {
+            usb_ep0_reply(deviceDescriptor, sizeof(deviceDescriptor), length);
+        }
+        else if(valueH == 0x02)
+        {
+            usb_ep0_reply(configDescriptor, sizeof(configDescriptor), length);
+        }
+        else if(valueH == 0x03 && valueL == 0)
+        {
+            usb_ep0_reply(string0Descriptor, sizeof(string0Descriptor), length);
+        }
+        else if(valueH == 0x03 && valueL == 1)
+        {
+            usb_ep0_reply(string1Descriptor, sizeof(string1Descriptor), length);
+        }
+        else if(valueH == 0x03 && valueL == 2)
+        {
+            usb_ep0_reply(string2Descriptor, sizeof(string2Descriptor), length);
+        }
+        else if(valueH == 0x21)
+        {
+            usb_ep0_reply(&configDescriptor[HID_DESCRIPTOR_OFFSET], 9, length);
+        }
+        else if(valueH == 0x22)
+        {
+            usb_ep0_reply(reportDescriptor, sizeof(reportDescriptor), length);
+        }
+        else
+        {
+            usb_ep0_stall();
+        }
+    }
+    else if(request == 0x05)                // SET_ADDRESS
+    {
+        usbAddress = valueL;    // Address changes after the status stage
+        usb_ep0_status();
+    }
+    else if(request == 0x09)                // SET_CONFIGURATION
+    {
+        usbConfigured = (valueL != 0);
+        UEP1 = usbConfigured ? 0b00011010 : 0;  // Endpoint 1: handshake, IN
+        usbBD[BD_EP1_IN].STAT = 0;
+        ep1DTS = false;
+        pressPending = false;   // Only measure presses made while configured
+        usb_ep0_status();
+        hid_send_report();      // Send the initial input state
+    }
+    else if(request == 0x08)                // GET_CONFIGURATION
+    {
+        ctrlReply[0] = usbConfigured ? 1 : 0;
+        usb_ep0_reply(ctrlReply, 1, length);
+    }
+    else if(request == 0x00)                // GET_STATUS
+    {
+        ctrlReply[0] = 0;       // Bus powered, no remote wake-up, not halted
+        ctrlReply[1] = 0;
+        usb_ep0_reply(ctrlReply, 2, length);
+    }
+    else if(request == 0x01 && requestType == 0x02 && indexL == 0x81)
+    {
+        // CLEAR_FEATURE(ENDPOINT_HALT) on endpoint 1: the host expects DATA0
+        // next, so cancel any stall or unsent report and re-send it as DATA0.
+        if(usbBD[BD_EP1_IN].STAT & BD_UOWN)
+        {
+            if(sentPress)
+            {
+                pressTime = sentPressTime;  // Keep the cancelled press time
+                pressPending = true;
+            }
+            reportPending = true;
+        }
+        usbBD[BD_EP1_IN].STAT = 0;
+        ep1DTS = false;
+        usb_ep0_status();
+        if(reportPending)
+        {
+            hid_send_report();
+        }
+    }
+    else if(request == 0x01 || request == 0x03) // CLEAR_FEATURE, SET_FEATURE
+    {
+        usb_ep0_status();
+    }
+    else
+    {
+        usb_ep0_stall();
+    }
+    UCONbits.PKTDIS = 0;        // Resume processing packets
+}
+
+// Handle a completed transaction reported in USTAT.
+static void usb_transaction(unsigned char ustat)
+{
+    unsigned char bd = (ustat >> 2) & 0x1F;
+    uint32_t elapsed;
+    unsigned int latency;
+
+    if(bd == BD_EP0_OUT)
+    {
+        if(BD_PID(usbBD[BD_EP0_OUT].STAT) == PID_SETUP)
+        {
+            usb_setup();
+        }
+        else
+        {
+            ctrlState = CTRL_IDLE;  // Host status stage finished
+            usb_ep0_receive();
+        }
+    }
+    else if(bd == BD_EP0_IN)
+    {
+        if(usbAddress != 0 && ctrlState == CTRL_STATUS_IN)
+        {
+            UADDR = usbAddress;
+            usbAddress = 0;
+        }
+        if(ctrlState == CTRL_DATA_IN)
+        {
+            if(ctrlLength != 0 || ctrlZeroLength)
+            {
+                if(ctrlLength == 0)
+                {
+                    ctrlZeroLength = false;
+                }
+                usb_ep0_send_data();
+            }
+            else
+            {
+                ctrlState = CTRL_STATUS_OUT;
+            }
+        }
+        else
+        {
+            ctrlState = CTRL_IDLE;
+        }
+    }
+    else if(bd == BD_EP1_IN)
+    {
+        // The host has received the report - measure press-to-report latency.
+        if(sentPress)
+        {
+            sentPress = false;
+            elapsed = TIMEBASE_ticks() - sentPressTime;
+            latency = (elapsed > 0xFFFF) ? 0xFFFF : (unsigned int)elapsed;
+            latencyTicks = latency;
+            if(latency > latencyMaxTicks)
+            {
+                latencyMaxTicks = latency;
+            }
+        }
+        if(reportPending)
+        {
+            hid_send_report();
+        }
+    }
+}
+
+// Configure USB, the timebase and pushbutton interrupts, and connect to the host.
+void USB_HID_config(void)
+{
+    unsigned char i;
+
+    UCON = 0;                   // Disconnect, so that the host sees a new device
+    UIE = 0;
+    __delay_ms(100);
+
+    TIMEBASE_config();
+    for(i = 0; i != 8; i++)
+    {
+        hidLockout[i] = 0;
+    }
+    hidInputs = hid_sample();
+
+    // Interrupt-on-change for both edges of the SW2-SW5 inputs
+    hidActive = true;
+    IOCBP = 0b11110000;
+    IOCBN = 0b11110000;
+    IOCBF = 0;
+    INTCONbits.IOCIE = 1;
+
+    UCFG = 0b00010100;          // On-chip pull-up, full speed, no ping-pong
+    usb_reset();
+    UIE = 0b01011001;           // SOF, idle, transaction and reset interrupts
+    PIR2bits.USBIF = 0;
+    PIE2bits.USBIE = 1;
+    PEIE = 1;                   // Enable peripheral interrupts
+    GIE = 1;                    // Enable global interrupts
+    UCONbits.USBEN = 1;         // Attach to the USB bus
+}
+
+// Run UBMP4 as a USB HID device. This function does not return.
+void USB_HID_mode(void)
+{
+    unsigned char inputs;
+    unsigned int latency;
+
+    USB_HID_config();
+    while(1)
+    {
+        inputs = USB_HID_inputs();
+        LED3 = (inputs & HID_SW2) ? 1 : 0;
+        LED4 = (inputs & HID_SW3) ? 1 : 0;
+        LED5 = (inputs & HID_SW4) ? 1 : 0;
+        LED6 = (inputs & HID_SW5) ? 1 : 0;
+        LED1 = USB_HID_configured() ? 0 : 1;    // Run LED is active-low
+
+        // Convert the latest latency for gamepad reports (outside of the ISR).
+        latency = USB_HID_latency_us(false);
+        GIE = 0;
+        latencyReportUs = latency;
+        GIE = 1;
+
+        // Activate bootloader if SW1 is pressed.
+        if(SW1 == 0)
+        {
+            UCON = 0;           // Detach from USB before resetting
+            RESET();
+        }
+    }
+}
+
+// Return true once the USB host has configured the device.
+bool USB_HID_configured(void)
+{
+    return (usbConfigured);
+}
+
+// Return the debounced input state.
+unsigned char USB_HID_inputs(void)
+{
+    return (hidInputs);
+}
+
+// Return the most recent or longest press-to-report latency in microseconds.
+unsigned int USB_HID_latency_us(bool longest)
+{
+    unsigned int ticks;
+
+    PIE2bits.USBIE = 0;         // Prevent the ISR changing the value mid-read
+    ticks = longest ? latencyMaxTicks : latencyTicks;
+    PIE2bits.USBIE = 1;
+    return ((unsigned int)TIMEBASE_us(ticks));
+}
+
+// USB and pushbutton interrupt handler (call from the ISR).
+void USB_HID_isr(void)
+{
+    unsigned char flags;
+    unsigned char i;
+    uint32_t now;
+
+    // Pushbutton changes: timestamp first, so that scan order adds no delay.
+    if(hidActive && INTCONbits.IOCIE && INTCONbits.IOCIF)
+    {
+        now = TIMEBASE_ticks();
+        flags = IOCBF & 0b11110000;
+        IOCBF = IOCBF & ~flags;
+        hid_inputs_update(hid_sample(), flags >> 4, now);
+    }
+
+    if(!(PIE2bits.USBIE && PIR2bits.USBIF))
+    {
+        return;
+    }
+    PIR2bits.USBIF = 0;
+
+    if(UIRbits.URSTIF)
+    {
+        usb_reset();            // Clears all USB interrupt flags
+        return;
+    }
+    if(UIRbits.ACTVIF)
+    {
+        UCONbits.SUSPND = 0;    // Bus activity resumed
+        UIEbits.ACTVIE = 0;
+        while(UIRbits.ACTVIF)
+        {
+            UIRbits.ACTVIF = 0;
+        }
+    }
+    if(UIRbits.IDLEIF)
+    {
+        UIRbits.IDLEIF = 0;
+        UIEbits.ACTVIE = 1;     // Wake up on bus activity
+        UCONbits.SUSPND = 1;
+    }
+    if(UIRbits.STALLIF)
+    {
+        UIRbits.STALLIF = 0;
+        UEP0bits.EPSTALL = 0;
+    }
+    if(UIRbits.UERRIF)
+    {
+        UEIR = 0;
+        UIRbits.UERRIF = 0;
+    }
+
+    // 1 ms frame tick: end debounce lock-outs and sample header inputs.
+    if(UIRbits.SOFIF)
+    {
+        UIRbits.SOFIF = 0;
+        flags = USB_HID_HEADERS << 4;
+        for(i = 0; i != 8; i++)
+        {
+            if(hidLockout[i] != 0)
+            {
+                hidLockout[i]--;
+                if(hidLockout[i] == 0)
+                {
+                    flags |= (1 << i);  // Re-check inputs after lock-out
+                }
+            }
+        }
+        hid_inputs_update(hid_sample(), flags, TIMEBASE_ticks());
+    }
+
+    while(UIRbits.TRNIF)
+    {
+        flags = USTAT;          // USTAT must be read before clearing TRNIF
+        UIRbits.TRNIF = 0;
+        usb_transaction(flags);
+    }
+}
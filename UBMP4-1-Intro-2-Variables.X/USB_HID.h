@@ -0,0 +1,106 @@
+/*==============================================================================
+ File: USB_HID.h
+ Date: October 18, 2026
+
+ UBMP4.1 (PIC16F1459) USB HID keyboard/gamepad device constant definitions and
+ function prototypes
+
+ Operation:
+ A minimal, interrupt-driven USB full-speed device stack that enumerates as a
+ HID keyboard or gamepad with a single interrupt IN endpoint polled by the host
+ every 1 ms. It relies on the 48 MHz USB clock set up by OSC_config() and on
+ the PIC16F1459-config.c configuration bits.
+
+ Pushbuttons SW2-SW5 are detected by interrupt-on-change and are reported as
+ soon as they change. Optional header inputs H1-H4 are sampled once every 1 ms
+ USB frame (header inputs need external pull-up resistors). Each input change
+ is reported immediately, and further changes of the same input are ignored for
+ USB_HID_DEBOUNCE_MS to filter out switch contact bounce. A new report is built
+ only when the input state changes - the host receives NAKs in between.
+
+ Latency:
+ The time from a pushbutton interrupt to the completion of the USB transaction
+ that delivered its report to the host is measured using TIMEBASE.c. The most
+ recent and longest latencies can be read with USB_HID_latency_us(), and, in
+ gamepad mode, the most recent latency is also included in each report as a
+ 16-bit vendor-defined input (in microseconds), so that it can be read on the
+ host using hidraw or a HID report viewer. Expect up to 1 ms (one host polling
+ interval) plus the interrupt latency.
+
+ USB_HID_mode() uses SW2-SW5, Timer1, and interrupt-on-change for PORTB, so it
+ should not be combined with EUSART.c (RB5/RB7) or with other uses of Timer1.
+==============================================================================*/
+
+// USB HID report types
+#define USB_HID_KEYBOARD    1       // Boot protocol compatible keyboard
+#define USB_HID_GAMEPAD     2       // 8 button gamepad
+
+// USB HID configuration
+#define USB_HID_TYPE        USB_HID_GAMEPAD     // Report type to enumerate as
+#define USB_HID_HEADERS     0b00000000  // Header inputs to add (H1-H4: 0b00001111)
+#define USB_HID_DEBOUNCE_MS 5       // Input lock-out time after each change
+#define USB_HID_VID         0x04D8  // USB vendor ID (Microchip Technology Inc.)
+#define USB_HID_PID         0x005E  // USB product ID - change for distribution
+
+// Input bit definitions for the button state returned by USB_HID_inputs().
+// In gamepad mode these are buttons 1-8, and in keyboard mode they send the
+// keys listed.
+#define HID_SW2     0b00000001      // SW2 - button 1, Z key
+#define HID_SW3     0b00000010      // SW3 - button 2, X key
+#define HID_SW4     0b00000100      // SW4 - button 3, C key
+#define HID_SW5     0b00001000      // SW5 - button 4, V key
+#define HID_H1      0b00010000      // H1 - button 5, 1 key
+#define HID_H2      0b00100000      // H2 - button 6, 2 key
+#define HID_H3      0b01000000      // H3 - button 7, 3 key
+#define HID_H4      0b10000000      // H4 - button 8, 4 key
+
+// Prototypes for USB_HID.c functions:
+
+/**
+ * Function: void USB_HID_config(void)
+ *
+ * Configure the USB module, Timer1 timebase and pushbutton interrupts, and
+ * connect to the USB host. Enumeration continues in the background.
+ */
+void USB_HID_config(void);
+
+/**
+ * Function: void USB_HID_mode(void)
+ *
+ * Run UBMP4 as a USB HID device. LEDs D3-D6 show the state of SW2-SW5, and
+ * LED D1 lights once the host has configured the device. Pressing SW1 resets
+ * UBMP4 into the bootloader. This function does not return.
+ */
+void USB_HID_mode(void);
+
+/**
+ * Function: bool USB_HID_configured(void)
+ *
+ * Return true once the USB host has enumerated and configured the device.
+ */
+bool USB_HID_configured(void);
+
+/**
+ * Function: unsigned char USB_HID_inputs(void)
+ *
+ * Return the debounced input state (see input bit definitions above).
+ */
+unsigned char USB_HID_inputs(void);
+
+/**
+ * Function: unsigned int USB_HID_latency_us(bool longest)
+ *
+ * Return the most recent (longest = false) or longest (longest = true)
+ * pushbutton press-to-report latency in microseconds.
+ *
+ * Example usage: worst = USB_HID_latency_us(true);
+ */
+unsigned int USB_HID_latency_us(bool);
+
+/**
+ * Function: void USB_HID_isr(void)
+ *
+ * USB and pushbutton interrupt handler. Call this function from the main
+ * program's interrupt service routine.
+ */
+void USB_HID_isr(void);
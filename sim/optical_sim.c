@@ -0,0 +1,217 @@
+/*==============================================================================
+ File: optical_sim.c
+ Date: October 18, 2026
+
+ Linux loopback simulation of the UBMP4.1 optical data link (OPTICAL.c)
+
+ The simulation compiles the firmware's OPTICAL.c and runs its Timer2
+ interrupt handler sample by sample, with the transmit LED looped back to the
+ phototransistor. The light level follows the LED through a first-order lag
+ (the phototransistor response), with uniform random noise added to each ADC
+ sample. Frames with a pseudo-random payload are sent one after another, and
+ every received frame is checked against the one sent.
+
+ Results:
+   frames       Frames sent, received with a good CRC and the right payload,
+                and lost (not received, CRC error or wrong payload)
+   bits         Payload bits in good frames
+
+ Build and run (from the repository directory):
+   gcc -std=c99 -O2 -Wall -Isim/pic -IUBMP4-1-Intro-2-Variables.X \
+       -o optical_sim sim/optical_sim.c \
+       UBMP4-1-Intro-2-Variables.X/OPTICAL.c UBMP4-1-Intro-2-Variables.X/CRC8.c
+   ./optical_sim [noise +/- ADC counts] [inverted 0/1] [frames] \
+       [payload bytes] [seed]
+ Add -g -fsanitize=address to the gcc options to check for out-of-bounds
+ buffer accesses, eg. with OPTICAL_MAX_PAYLOAD byte frames.
+==============================================================================*/
+
+#include    <stdio.h>
+#include    <stdlib.h>
+
+#include    "xc.h"              // Simulated PIC registers
+
+#include    "stdint.h"          // Include integer definitions
+#include    "stdbool.h"         // Include Boolean (true/false) definitions
+
+#include    "UBMP410.h"         // Include UBMP4.1 constant and function definitions
+#include    "OPTICAL.h"         // Include optical link constant and function definitions
+
+// Light level model (ADC counts)
+#define LIGHT_LEVEL     180.0   // Phototransistor level with the LED on
+#define DARK_LEVEL      60.0    // Phototransistor level with the LED off
+#define RESPONSE        0.6     // Fraction of a level change seen per sample
+
+#define GAP_SAMPLES     (OPTICAL_SAMPLES_PER_BIT * 4)   // Between frames
+
+// Simulated PIC registers (xc.h)
+volatile unsigned char ADRESH;
+volatile unsigned char PR2;
+volatile unsigned char T2CON;
+volatile unsigned char TMR2;
+volatile unsigned char GIE;
+volatile unsigned char PEIE;
+volatile unsigned char GO;
+volatile unsigned char TMR2IE;
+volatile unsigned char TMR2IF;
+volatile PORTAbits_t PORTAbits;
+volatile PORTBbits_t PORTBbits;
+volatile LATCbits_t LATCbits;
+
+double light = DARK_LEVEL;      // Phototransistor level
+double noise = 0.0;             // Largest noise (ADC counts)
+bool inverted = false;          // LED on gives a lower ADC level
+
+// Random number generator (xorshift64), for repeatable runs
+uint64_t randomState = 88172645463325252ULL;
+
+static double random_uniform(void)
+{
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 7;
+    randomState ^= randomState << 17;
+    return ((randomState >> 11) * (1.0 / 9007199254740992.0));
+}
+
+// Functions used by OPTICAL.c that aren't simulated
+void RESET(void)
+{
+    exit(0);
+}
+
+void ADC_config(void)
+{
+}
+
+void ADC_select_channel(unsigned char channel)
+{
+    (void)channel;
+}
+
+void TIMEBASE_config(void)
+{
+}
+
+uint32_t TIMEBASE_ticks(void)
+{
+    return (0);
+}
+
+void EUSART_config(unsigned int baud)
+{
+    (void)baud;
+}
+
+void EUSART_report(const char *text)
+{
+    (void)text;
+}
+
+void EUSART_report_u32(uint32_t value)
+{
+    (void)value;
+}
+
+// One Timer2 interrupt: the last ADC conversion sees the LED level from the
+// last sample.
+static void sample(void)
+{
+    double level;
+    double adc;
+
+    level = (OPTICAL_LED ^ inverted) ? LIGHT_LEVEL : DARK_LEVEL;
+    light += (level - light) * RESPONSE;
+    adc = light + noise * (random_uniform() * 2.0 - 1.0);
+    if(adc < 0.0)
+    {
+        adc = 0.0;
+    }
+    if(adc > 255.0)
+    {
+        adc = 255.0;
+    }
+    ADRESH = (unsigned char)adc;
+    TMR2IF = 1;
+    OPTICAL_isr();
+}
+
+int main(int argc, char **argv)
+{
+    unsigned char sent[OPTICAL_MAX_PAYLOAD];
+    unsigned char received[OPTICAL_MAX_PAYLOAD];
+    unsigned long frames = 1000;
+    unsigned long good = 0;
+    unsigned long lost = 0;
+    unsigned long f;
+    unsigned int payload = OPTICAL_BER_PAYLOAD;
+    unsigned int length;
+    unsigned int i;
+
+    if(argc > 1)
+    {
+        noise = atof(argv[1]);
+    }
+    if(argc > 2)
+    {
+        inverted = atoi(argv[2]) != 0;
+    }
+    if(argc > 3)
+    {
+        frames = strtoul(argv[3], NULL, 10);
+    }
+    if(argc > 4)
+    {
+        payload = (unsigned int)atoi(argv[4]);
+    }
+    if(argc > 5)
+    {
+        randomState ^= (uint64_t)atol(argv[5]) * 2654435761ULL;
+    }
+    if(payload < 1 || payload > OPTICAL_MAX_PAYLOAD || noise < 0.0)
+    {
+        fprintf(stderr, "usage: %s [noise +/- ADC counts] [inverted 0/1] [frames] [payload bytes 1-%d] [seed]\n",
+                argv[0], OPTICAL_MAX_PAYLOAD);
+        return (1);
+    }
+
+    OPTICAL_config();
+    for(i = 0; i != GAP_SAMPLES; i++)
+    {
+        sample();               // Let the receiver find the light levels
+    }
+
+    for(f = 0; f != frames; f++)
+    {
+        for(i = 0; i != payload; i++)
+        {
+            sent[i] = (unsigned char)(random_uniform() * 256.0);
+        }
+        OPTICAL_send(sent, (unsigned char)payload);
+        while(OPTICAL_tx_busy())
+        {
+            sample();
+        }
+        for(i = 0; i != GAP_SAMPLES; i++)
+        {
+            sample();
+        }
+
+        length = OPTICAL_receive(received);
+        for(i = 0; i != length && received[i] == sent[i]; i++)
+            ;
+        if(length == payload && i == length)
+        {
+            good++;
+        }
+        else
+        {
+            lost++;
+        }
+    }
+
+    printf("noise +/-%.0f ADC counts, %s, %u byte payload, %d samples per bit\n",
+            noise, inverted ? "inverted" : "not inverted", payload, OPTICAL_SAMPLES_PER_BIT);
+    printf("frames: sent %lu, good %lu, lost %lu\n", frames, good, lost);
+    printf("bits: %lu in good frames\n", good * payload * 8);
+    return (0);
+}
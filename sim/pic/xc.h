@@ -0,0 +1,63 @@
+/*==============================================================================
+ File: xc.h
+ Date: October 18, 2026
+
+ Linux stand-in for the XC8 compiler include file, for compiling firmware files
+ into the simulations. Only the PIC16F1459 registers and bits used by those
+ files are declared, as ordinary variables, and the simulation that uses them
+ defines them.
+==============================================================================*/
+
+void RESET(void);
+#define __delay_us(x)
+
+// Registers
+extern volatile unsigned char ADCON0;
+extern volatile unsigned char ADCON1;
+extern volatile unsigned char ADCON2;
+extern volatile unsigned char ADRESH;
+extern volatile unsigned char ADRESL;
+extern volatile unsigned char ANSELC;
+extern volatile unsigned char LATC;
+extern volatile unsigned char TRISC;
+extern volatile unsigned char PR2;
+extern volatile unsigned char T2CON;
+extern volatile unsigned char TMR2;
+
+// Register bits
+extern volatile unsigned char GIE;
+extern volatile unsigned char PEIE;
+extern volatile unsigned char GO;
+extern volatile unsigned char ADIE;
+extern volatile unsigned char ADIF;
+extern volatile unsigned char TMR2IE;
+extern volatile unsigned char TMR2IF;
+
+// Port bits
+typedef struct
+{
+    unsigned RA3 : 1;
+} PORTAbits_t;
+extern volatile PORTAbits_t PORTAbits;
+
+typedef struct
+{
+    unsigned RB4 : 1;
+    unsigned RB5 : 1;
+    unsigned RB6 : 1;
+    unsigned RB7 : 1;
+} PORTBbits_t;
+extern volatile PORTBbits_t PORTBbits;
+
+typedef struct
+{
+    unsigned LATC0 : 1;
+    unsigned LATC1 : 1;
+    unsigned LATC2 : 1;
+    unsigned LATC3 : 1;
+    unsigned LATC4 : 1;
+    unsigned LATC5 : 1;
+    unsigned LATC6 : 1;
+    unsigned LATC7 : 1;
+} LATCbits_t;
+extern volatile LATCbits_t LATCbits;
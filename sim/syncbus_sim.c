@@ -0,0 +1,421 @@
+/*==============================================================================
+ File: syncbus_sim.c
+ Date: October 18, 2026
+
+ Linux simulation of a UBMP4.1 sync bus (SYNCBUS.c) with several nodes
+
+ The simulation runs the master and the nodes bit clock period by bit clock
+ period. Every board runs the firmware's own bus state machine (SYNCMSG.c) -
+ this file only replaces SYNCBUS.c's pins, timebase and interrupts. Each board
+ has its own oscillator error, and each clock edge interrupt has its own
+ latency, occasionally lengthened by another interrupt. A node's data bit is
+ received wrongly if its interrupt handler sets it too late for the master,
+ which happens if the handlers for earlier edges take too long.
+
+ The interrupt timing below is an estimate for the XC8 -O0 image. Measure the
+ built image with SYNCBUS_TIMING_PIN (SYNCBUS.h) on an oscilloscope, and set
+ the timing to the measured values:
+   EDGE_LATENCY     H2 falling edge to H3 rising edge on a node
+   HANDLER_TIME     H3 high time on a node, for most edges
+   TICK_TIME        extra H3 high time on a node at a tick (first edge of a
+                    burst)
+   MASTER_LATENCY   H3 rising edge to H2 falling edge on the master
+ HANDLER_TIME can also be given on the command line, to find the longest
+ handler time the bus works with.
+
+ Results:
+   bus          Bit clock periods with clock edges, and used by message slots
+                (the master's SYNCBUS_mode() "bus" figure)
+   sync error   Common time of each press calculated by the master, compared
+                with the master's clock at the moment the node timestamped it
+   clock error  SYNCBUS_time_us() of the nodes compared with the master's clock
+   latency      Press to reception of its message by the master
+   late edges   Node clock edges handled after the next edge, and the latest
+                data output after a clock edge
+
+ Build and run (from the repository directory):
+   gcc -std=c99 -O2 -Wall -IUBMP4-1-Intro-2-Variables.X -o syncbus_sim \
+       sim/syncbus_sim.c UBMP4-1-Intro-2-Variables.X/SYNCMSG.c \
+       UBMP4-1-Intro-2-Variables.X/CRC8.c -lm
+   ./syncbus_sim [nodes] [seconds] [presses/s per node] [oscillator error %] \
+       [seed] [handler time us]
+==============================================================================*/
+
+#include    <stdio.h>
+#include    <stdlib.h>
+#include    <math.h>
+
+#include    "stdint.h"          // Include integer definitions
+#include    "stdbool.h"         // Include Boolean (true/false) definitions
+
+#include    "SYNCBUS.h"         // Include sync bus constant definitions
+#include    "SYNCMSG.h"         // Include sync bus state machine definitions
+
+#define PRESS_MASK      (SYNCBUS_QUEUE_SIZE - 1)
+#define RX_MASK         (SYNCBUS_RX_SIZE - 1)
+
+// Interrupt timing model (us). Estimated, not measured - see above.
+#define EDGE_LATENCY    1.0     // Clock edge to node handler (data output set)
+#define EDGE_JITTER     1.0     // Random extra edge latency
+#define BLOCK_CHANCE    0.002   // Chance of another interrupt delaying an edge
+#define BLOCK_TIME      12.0    // Longest delay by another interrupt
+#define STAMP_TIME      5.0     // Node handler start to tick timestamp
+#define SAMPLE_TIME     8.0     // Node handler start to header bit read
+#define HANDLER_TIME    15.0    // Node handler time
+#define TICK_TIME       15.0    // Extra node handler time at a tick
+#define MASTER_LATENCY  1.0     // Master bit clock interrupt to clock edge
+#define PRESS_LATENCY   2.0     // Pushbutton press to timestamp
+
+// One board: the firmware bus state, and the simulation state around it
+typedef struct
+{
+    SYNCMSG_BUS bus;            // Bus state, as in SYNCBUS.c
+    double osc;                 // Oscillator error (fraction)
+    double phase;               // Timebase at time 0 (us)
+    double handlerEnd;          // End of the last clock edge interrupt
+    double nextPress;           // Time of the next press
+    double pressTruth[SYNCBUS_QUEUE_SIZE];  // Master clock at press timestamps
+    double msgTruth;            // Master clock at the press being sent
+    double sentTruth;           // Master clock at the press just sent
+    double handlerStart;        // Start of the last clock edge interrupt
+    double driveTime;           // When the data output changes to dataOut
+    bool dataOut;               // Data output (true = released)
+    bool dataPrev;              // Data output before driveTime
+} BOARD;
+
+BOARD boards[SYNCBUS_NODES];
+unsigned char nodes = SYNCBUS_NODES;
+double handlerTime = HANDLER_TIME;
+
+// Master clock at each received message's press, and at its reception
+double rxTruth[SYNCBUS_RX_SIZE];
+double rxTime[SYNCBUS_RX_SIZE];
+
+// Results
+unsigned long presses = 0, received = 0;
+unsigned long edges = 0, bitPeriods = 0;
+double syncSum = 0, syncWorst = 0, clockWorst = 0;
+double latencySum = 0, latencyWorst = 0;
+unsigned long clockSamples = 0;
+unsigned long lateEdges = 0;
+double driveWorst = 0;
+
+// Random number generator (xorshift64), for repeatable runs
+uint64_t randomState = 88172645463325252ULL;
+
+static double random_uniform(void)
+{
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 7;
+    randomState ^= randomState << 17;
+    return ((randomState >> 11) * (1.0 / 9007199254740992.0));
+}
+
+// Board timebase (1.5 ticks per us) and master clock (common us) at a time
+static uint32_t board_ticks(const BOARD *b, double t)
+{
+    return ((uint32_t)(uint64_t)floor((t * (1.0 + b->osc) + b->phase) * 1.5));
+}
+
+// Board coarse timebase (TIMEBASE_COARSE) at a time
+static unsigned char board_coarse(const BOARD *b, double t)
+{
+    return ((unsigned char)(board_ticks(b, t) >> 8));
+}
+
+static double master_clock(double t)
+{
+    return (t * (1.0 + boards[0].osc) - MASTER_LATENCY);  // Ticks are at edges
+}
+
+// Time of a master clock value
+static double master_time(double us)
+{
+    return (us / (1.0 + boards[0].osc));
+}
+
+// Main loop: SYNCBUS_poll(), and the master's SYNCBUS_event() handling
+static void board_poll(BOARD *b, double t)
+{
+    SYNCBUS_EVENT event;
+    unsigned char tail;
+    unsigned char entry;
+    double error;
+    double latency;
+
+    tail = b->bus.pressTail;
+    SYNCMSG_poll(&b->bus);
+    if(b->bus.pressTail != tail)
+    {
+        b->msgTruth = b->pressTruth[tail & PRESS_MASK];
+    }
+
+    if(b == &boards[0])
+    {
+        while(SYNCMSG_event(&b->bus, &event))
+        {
+            entry = (b->bus.rxTail - 1) & RX_MASK;
+            received++;
+            error = event.time - rxTruth[entry];
+            syncSum += fabs(error);
+            if(fabs(error) > syncWorst)
+            {
+                syncWorst = fabs(error);
+            }
+            latency = rxTime[entry] - rxTruth[entry];
+            latencySum += latency;
+            if(latency > latencyWorst)
+            {
+                latencyWorst = latency;
+            }
+        }
+        return;
+    }
+
+    // Sample SYNCBUS_time_us() against the master's clock, after the clock
+    // edge interrupt handler.
+    if(t < b->handlerEnd)
+    {
+        t = b->handlerEnd;
+    }
+    if(SYNCMSG_synced(&b->bus, board_ticks(b, t)) && random_uniform() < 0.01)
+    {
+        error = (double)SYNCMSG_time_us(&b->bus, board_ticks(b, t)) - master_clock(t);
+        if(fabs(error) > clockWorst)
+        {
+            clockWorst = fabs(error);
+        }
+        clockSamples++;
+    }
+}
+
+// Node presses, timestamped by the pushbutton interrupt
+static void board_presses(BOARD *b, double t, double rate)
+{
+    double stamp;
+    unsigned char head;
+
+    while(b->nextPress <= t)
+    {
+        presses++;
+        stamp = b->nextPress + PRESS_LATENCY;
+        head = b->bus.pressHead;
+        SYNCMSG_press(&b->bus, (unsigned char)(1 << (presses & 3)), board_ticks(b, stamp));
+        if(b->bus.pressHead != head)
+        {
+            b->pressTruth[head & PRESS_MASK] = master_clock(stamp);
+        }
+        b->nextPress += -log(1.0 - random_uniform()) * 1e6 / rate;
+    }
+}
+
+// Data line level at a time (wired-AND of every board's output)
+static bool data_line(double t)
+{
+    bool level = true;
+    unsigned char n;
+
+    for(n = 0; n != nodes; n++)
+    {
+        level &= (boards[n].driveTime <= t) ? boards[n].dataOut : boards[n].dataPrev;
+    }
+    return (level);
+}
+
+static void data_drive(BOARD *b, bool level, double t)
+{
+    b->dataPrev = (b->driveTime <= t) ? b->dataOut : b->dataPrev;
+    b->dataOut = level;
+    b->driveTime = t;
+}
+
+// Node clock edge interrupt handler (SYNCBUS_isr()). The INT flag holds one
+// edge, so an edge during the handler is handled after it, and a second edge
+// during the handler is missed.
+static void node_edge(BOARD *b, double edge, double nextEdge)
+{
+    double start;
+    double sample;
+    unsigned int slotsUsed;
+    bool tick;
+
+    start = edge + EDGE_LATENCY + EDGE_JITTER * random_uniform();
+    if(random_uniform() < BLOCK_CHANCE)
+    {
+        start += BLOCK_TIME * random_uniform();
+    }
+    if(start < b->handlerEnd)
+    {
+        if(b->handlerStart > edge)
+        {
+            return;             // Missed: an earlier edge is still pending
+        }
+        start = b->handlerEnd;  // Previous interrupt still running
+    }
+    if(start >= nextEdge)
+    {
+        lateEdges++;
+    }
+    if(start - edge > driveWorst)
+    {
+        driveWorst = start - edge;
+    }
+    b->handlerStart = start;
+
+    // The data output prepared at the last edge is set first.
+    data_drive(b, b->bus.dataOut, start);
+    tick = SYNCMSG_node_edge(&b->bus, board_coarse(b, start));
+    if(tick)
+    {
+        SYNCMSG_node_tick(&b->bus, board_ticks(b, start + STAMP_TIME));
+    }
+
+    // A late read gets the master's next header bit (modelled as an error).
+    sample = start + SAMPLE_TIME + (tick ? TICK_TIME : 0.0);
+    slotsUsed = b->bus.slotsUsed;
+    SYNCMSG_node_bit(&b->bus, data_line(sample) ^ (sample >= nextEdge - MASTER_LATENCY));
+    if(b->bus.slotsUsed != slotsUsed)
+    {
+        b->sentTruth = b->msgTruth;     // Press event message sent
+    }
+    b->handlerEnd = start + handlerTime + (tick ? TICK_TIME : 0.0);
+}
+
+int main(int argc, char **argv)
+{
+    double seconds = 60.0;
+    double rate = 5.0;
+    double tolerance = 1.0;
+    double t;
+    double edge;
+    double nextEdge;
+    uint32_t k;
+    uint32_t ticks;
+    unsigned long sent = 0;
+    unsigned long dropped = 0;
+    unsigned int b;
+    unsigned char n;
+    unsigned char head;
+    unsigned char entry;
+    bool level;
+    bool clockEdge;
+    BOARD *m = &boards[0];
+
+    if(argc > 1)
+    {
+        nodes = (unsigned char)atoi(argv[1]);
+    }
+    if(argc > 2)
+    {
+        seconds = atof(argv[2]);
+    }
+    if(argc > 3)
+    {
+        rate = atof(argv[3]);
+    }
+    if(argc > 4)
+    {
+        tolerance = atof(argv[4]);
+    }
+    if(argc > 5)
+    {
+        randomState ^= (uint64_t)atol(argv[5]) * 2654435761ULL;
+    }
+    if(argc > 6)
+    {
+        handlerTime = atof(argv[6]);
+    }
+    if(nodes < 2 || nodes > SYNCBUS_NODES || rate <= 0 || handlerTime < SAMPLE_TIME)
+    {
+        fprintf(stderr, "usage: %s [nodes 2-%d] [seconds] [presses/s per node] [oscillator error %%] [seed] [handler time us]\n",
+                argv[0], SYNCBUS_NODES);
+        return (1);
+    }
+
+    for(n = 0; n != nodes; n++)
+    {
+        boards[n].osc = (random_uniform() * 2.0 - 1.0) * tolerance / 100.0;
+        boards[n].phase = random_uniform() * 1e6;
+        boards[n].dataOut = true;
+        boards[n].dataPrev = true;
+        boards[n].nextPress = 1.0 + random_uniform() * 1e6 / rate;  // After start-up
+    }
+    m->osc = 0.0;               // The master's clock is the common time
+    for(n = 0; n != nodes; n++)
+    {
+        SYNCMSG_init(&boards[n].bus, n, board_ticks(&boards[n], 0.0));
+    }
+
+    ticks = (uint32_t)(seconds * 1e6 / SYNCBUS_TICK_US);
+    for(k = 1; k <= ticks; k++)
+    {
+        for(b = 0; b != SYNCBUS_PERIOD_BITS; b++)
+        {
+            // Master bit clock interrupt: sample the node bit, set the
+            // prepared header bit and make the clock edge, then move to the
+            // new bit clock period.
+            t = master_time(((double)k * SYNCBUS_PERIOD_BITS + b) * SYNCBUS_BIT_US);
+            level = data_line(t);
+            data_drive(m, m->bus.dataOut, t);
+            edge = t + master_time(MASTER_LATENCY);
+            clockEdge = (m->bus.bit == SYNCBUS_PERIOD_BITS - 1 ||
+                    m->bus.bit < SYNCBUS_BURST_BITS - 1);
+            if(m->bus.bit == SYNCBUS_PERIOD_BITS - 1)
+            {
+                SYNCMSG_master_tick(&m->bus, board_ticks(m, edge));
+            }
+            head = m->bus.rxHead;
+            SYNCMSG_master_bit(&m->bus, level);
+            if(m->bus.rxHead != head)
+            {
+                entry = head & RX_MASK;
+                rxTruth[entry] = boards[m->bus.rxNode[entry]].sentTruth;
+                rxTime[entry] = master_clock(t);
+            }
+            bitPeriods++;
+            if(clockEdge)
+            {
+                nextEdge = master_time(((double)k * SYNCBUS_PERIOD_BITS + b + 1) * SYNCBUS_BIT_US) +
+                        master_time(MASTER_LATENCY);
+                edges++;
+                for(n = 1; n != nodes; n++)
+                {
+                    node_edge(&boards[n], edge, nextEdge);
+                }
+            }
+
+            // Main loops
+            for(n = 0; n != nodes; n++)
+            {
+                if(n != 0)
+                {
+                    board_presses(&boards[n], t, rate);
+                }
+                board_poll(&boards[n], t);
+            }
+        }
+    }
+
+    for(n = 0; n != nodes; n++)
+    {
+        if(n != 0)
+        {
+            sent += boards[n].bus.slotsUsed;
+        }
+        dropped += boards[n].bus.dropped;
+    }
+    printf("nodes %u, %.0f s, %.1f presses/s per node, oscillator error up to %.2f%%\n",
+            nodes, seconds, rate, tolerance);
+    printf("bus: clock edges %.1f%%, message slots %.1f%% of bit clock periods\n",
+            100.0 * edges / bitPeriods, 100.0 * m->bus.slotsUsed * SYNCBUS_SLOT_BITS / bitPeriods);
+    printf("presses %lu, sent %lu, received %lu, errors %u, dropped %lu\n",
+            presses, sent, received, m->bus.errors, dropped);
+    printf("sync error: mean %.2f us, worst %.2f us\n",
+            received ? syncSum / received : 0.0, syncWorst);
+    printf("clock error: worst %.2f us (%lu samples)\n", clockWorst, clockSamples);
+    printf("latency: mean %.2f ms, worst %.2f ms\n",
+            received ? latencySum / received / 1000.0 : 0.0, latencyWorst / 1000.0);
+    printf("late edges: %lu, worst data output delay %.2f us (handler time %.1f us)\n",
+            lateEdges, driveWorst, handlerTime);
+    return (0);
+}
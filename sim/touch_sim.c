@@ -0,0 +1,177 @@
+/*==============================================================================
+ File: touch_sim.c
+ Date: October 18, 2026
+
+ Linux simulation of UBMP4.1 touch key baseline tracking (TOUCH.c)
+
+ The simulation compiles the firmware's TOUCH.c and runs its three-step
+ interrupt-driven measurement of two keys (H1 and H2), giving the ADC results
+ that make up each measurement. H1's measurement starts at BASE_LEVEL and then
+ rises (or falls) by a fixed step below the touch thresholds, as with slow
+ drift from humidity or temperature, plus optional uniform random noise. The
+ baseline that TOUCH_baseline() reports is printed as it tracks the new level.
+
+ Results:
+   baseline     H1's baseline every REPORT_SCANS scans after the step
+   tracked      Scans after the step until the baseline is within 1 count of
+                the new level
+   touches      False touches detected during the run (should be 0)
+
+ Build and run (from the repository directory):
+   gcc -std=c99 -O2 -Wall -Isim/pic -IUBMP4-1-Intro-2-Variables.X \
+       -o touch_sim sim/touch_sim.c UBMP4-1-Intro-2-Variables.X/TOUCH.c
+   ./touch_sim [step counts] [scans] [noise +/- counts] [seed]
+
+ int is 32 bits here and 16 bits on the PIC, so the results only apply while
+ the 16-bit values don't overflow (measurements below 2048).
+==============================================================================*/
+
+#include    <stdio.h>
+#include    <stdlib.h>
+
+#include    "xc.h"              // Simulated PIC registers
+
+#include    "stdint.h"          // Include integer definitions
+#include    "stdbool.h"         // Include Boolean (true/false) definitions
+
+#include    "UBMP410.h"         // Include UBMP4.1 constant and function definitions
+#include    "TOUCH.h"           // Include touch sensing constant and function definitions
+
+#define BASE_LEVEL      500     // Measurement before the step (counts)
+#define SETTLE_SCANS    100     // Scans at BASE_LEVEL before the step
+#define REPORT_SCANS    500     // Scans between baseline reports
+#define FIRST_RESULT    900     // Forward conversion result
+
+// Simulated PIC registers (xc.h)
+volatile unsigned char ADCON0;
+volatile unsigned char ADCON1;
+volatile unsigned char ADCON2;
+volatile unsigned char ADRESH;
+volatile unsigned char ADRESL;
+volatile unsigned char ANSELC;
+volatile unsigned char LATC;
+volatile unsigned char TRISC;
+volatile unsigned char PR2;
+volatile unsigned char T2CON;
+volatile unsigned char TMR2;
+volatile unsigned char GIE;
+volatile unsigned char PEIE;
+volatile unsigned char GO;
+volatile unsigned char ADIE;
+volatile unsigned char ADIF;
+volatile unsigned char TMR2IE;
+volatile unsigned char TMR2IF;
+
+// Random number generator (xorshift64), for repeatable runs
+uint64_t randomState = 88172645463325252ULL;
+
+static double random_uniform(void)
+{
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 7;
+    randomState ^= randomState << 17;
+    return ((randomState >> 11) * (1.0 / 9007199254740992.0));
+}
+
+void RESET(void)
+{
+    exit(0);
+}
+
+// Set the left justified 10-bit ADC result and run the ADC interrupt.
+static void adc_done(unsigned int result)
+{
+    ADRESH = (unsigned char)(result >> 2);
+    ADRESL = (unsigned char)(result << 6);
+    ADIF = 1;
+    TOUCH_isr();
+}
+
+// Measure the next key. The forward conversion is fixed at FIRST_RESULT, so
+// the second conversion sets the measurement (1023 + second - first).
+static void scan(unsigned int h1, unsigned int h2)
+{
+    unsigned int level;
+
+    TMR2IF = 1;
+    TOUCH_isr();                // Step 1: TOUCH.c selects the next key
+    level = (ADCON0 == (ANH1 | 0b00000001)) ? h1 : h2;
+    adc_done(FIRST_RESULT);     // Step 2
+    adc_done(level + FIRST_RESULT - 1023);  // Step 3
+}
+
+int main(int argc, char **argv)
+{
+    int step = 10;
+    unsigned long scans = 5000;
+    double noise = 0.0;
+    unsigned long s;
+    unsigned long tracked = 0;
+    unsigned int level;
+    unsigned int touches = 0;
+    unsigned int base;
+    unsigned char keys = 0;
+
+    if(argc > 1)
+    {
+        step = atoi(argv[1]);
+    }
+    if(argc > 2)
+    {
+        scans = strtoul(argv[2], NULL, 10);
+    }
+    if(argc > 3)
+    {
+        noise = atof(argv[3]);
+    }
+    if(argc > 4)
+    {
+        randomState ^= (uint64_t)atol(argv[4]) * 2654435761ULL;
+    }
+    if(step <= -100 || step >= TOUCH_PRESS_THRESHOLD || noise < 0.0 || noise > 100.0)
+    {
+        fprintf(stderr, "usage: %s [step counts, below %d] [scans] [noise +/- counts] [seed]\n",
+                argv[0], TOUCH_PRESS_THRESHOLD);
+        return (1);
+    }
+
+    TOUCH_config(TOUCH_H1 | TOUCH_H2);
+    printf("step %+d counts from %d, noise +/-%.0f counts\n", step, BASE_LEVEL, noise);
+    for(s = 0; s != SETTLE_SCANS + scans; s++)
+    {
+        level = BASE_LEVEL + (s >= SETTLE_SCANS ? step : 0);
+        level += (int)(noise * (random_uniform() * 2.0 - 1.0));
+        scan(level, BASE_LEVEL);
+        scan(level, BASE_LEVEL);
+        if((TOUCH_keys() & TOUCH_H1) && !(keys & TOUCH_H1))
+        {
+            touches++;
+        }
+        keys = TOUCH_keys();
+
+        if(s < SETTLE_SCANS)
+        {
+            continue;
+        }
+        base = TOUCH_baseline(TOUCH_H1);
+        if(tracked == 0 && abs((int)base - (BASE_LEVEL + step)) <= 1)
+        {
+            tracked = s - SETTLE_SCANS + 1;
+        }
+        if((s - SETTLE_SCANS) % REPORT_SCANS == 0)
+        {
+            printf("scan %5lu: baseline %u\n", s - SETTLE_SCANS, base);
+        }
+    }
+    printf("baseline: %u after %lu scans\n", TOUCH_baseline(TOUCH_H1), scans);
+    if(tracked != 0)
+    {
+        printf("tracked: within 1 count after %lu scans\n", tracked);
+    }
+    else
+    {
+        printf("tracked: not within 1 count\n");
+    }
+    printf("touches: %u\n", touches);
+    return (0);
+}